@@ -0,0 +1,104 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "stats.h"
+
+#if ANITOMY_ENABLE_STATS && !defined(ANITOMY_DISABLE_ALLOCATION_HOOK)
+
+#include <cstdlib>
+#include <new>
+
+#if __cplusplus >= 201103L
+#define ANITOMY_THROW_BAD_ALLOC
+#define ANITOMY_NOTHROW noexcept
+#else
+#define ANITOMY_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define ANITOMY_NOTHROW throw()
+#endif
+
+// Every block starts with its size, so that deallocations can be counted
+// without help from the C library. The header keeps malloc's alignment.
+static const std::size_t kHeaderSize = 16;
+
+static void* Allocate(std::size_t size) {
+  char* block = static_cast<char*>(std::malloc(size + kHeaderSize));
+  if (!block)
+    return NULL;
+  *reinterpret_cast<std::size_t*>(block) = size;
+  anitomy::RecordAllocation(size);
+  return block + kHeaderSize;
+}
+
+static void Deallocate(void* pointer) {
+  if (!pointer)
+    return;
+  char* block = static_cast<char*>(pointer) - kHeaderSize;
+  anitomy::RecordDeallocation(*reinterpret_cast<std::size_t*>(block));
+  std::free(block);
+}
+
+void* operator new(std::size_t size) ANITOMY_THROW_BAD_ALLOC {
+  void* pointer = Allocate(size);
+  if (!pointer)
+    throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new[](std::size_t size) ANITOMY_THROW_BAD_ALLOC {
+  void* pointer = Allocate(size);
+  if (!pointer)
+    throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) ANITOMY_NOTHROW {
+  return Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) ANITOMY_NOTHROW {
+  return Allocate(size);
+}
+
+void operator delete(void* pointer) ANITOMY_NOTHROW {
+  Deallocate(pointer);
+}
+
+void operator delete[](void* pointer) ANITOMY_NOTHROW {
+  Deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) ANITOMY_NOTHROW {
+  Deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) ANITOMY_NOTHROW {
+  Deallocate(pointer);
+}
+
+// C++14 compilers may call these instead; the size is in the header anyway
+#if __cplusplus >= 201402L
+void operator delete(void* pointer, std::size_t) ANITOMY_NOTHROW {
+  Deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) ANITOMY_NOTHROW {
+  Deallocate(pointer);
+}
+#endif
+
+#endif  // ANITOMY_ENABLE_STATS
\ No newline at end of file
@@ -24,59 +24,47 @@
 
 namespace anitomy {
 
-bool Anitomy::Parse(string_t filename) {
-  elements_.clear();
-  tokens_.clear();
-
-  if (options_.parse_file_extension) {
-    string_t extension;
-    if (RemoveExtensionFromFilename(filename, extension))
-      elements_.insert(kElementFileExtension, extension);
-  }
-
-  if (!options_.ignored_strings.empty())
-    RemoveIgnoredStrings(filename);
+Anitomy::Anitomy() : keywords_(&keyword_manager) {
+}
 
-  if (filename.empty())
-    return false;
-  elements_.insert(kElementFileName, filename);
+bool Anitomy::Parse(const string_t& filename) {
+  return Parse(filename, RuntimeProfile(options_));
+}
 
-  Tokenizer tokenizer(filename, elements_, options_, tokens_);
-  if (!tokenizer.Tokenize())
-    return false;
+bool Anitomy::Parse(StringView filename) {
+  return Parse(filename, RuntimeProfile(options_));
+}
 
-  Parser parser(elements_, options_, tokens_);
-  if (!parser.Parse())
-    return false;
+bool Anitomy::ParseInto(const string_t& filename, ElementSink& sink) {
+  return ParseInto(filename, sink, RuntimeProfile(options_));
+}
 
-  return true;
+bool Anitomy::ParseInto(StringView filename, ElementSink& sink) {
+  return ParseInto(filename, sink, RuntimeProfile(options_));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Anitomy::RemoveExtensionFromFilename(string_t& filename,
-                                          string_t& extension) const {
+// Returns the position of the dot before the extension, or npos
+size_t Anitomy::FindExtension(const string_t& filename) const {
   const size_t position = filename.find_last_of(L'.');
 
   if (position == string_t::npos)
-    return false;
-
-  extension = filename.substr(position + 1);
+    return string_t::npos;
 
   const size_t max_length = 4;
-  if (extension.length() > max_length)
-    return false;
+  if (filename.size() - position - 1 > max_length)
+    return string_t::npos;
 
+  const string_t extension = filename.substr(position + 1);
   if (!IsAlphanumericString(extension))
-    return false;
-
-  string_t keyword = keyword_manager.Normalize(extension);
-  if (!keyword_manager.Find(kElementFileExtension, keyword))
-    return false;
+    return string_t::npos;
 
-  filename.resize(position);
+  string_t keyword = keywords_->Normalize(extension);
+  if (!keywords_->Find(kElementFileExtension, keyword))
+    return string_t::npos;
 
-  return true;
+  return position;
 }
 
 void Anitomy::RemoveIgnoredStrings(string_t& filename) const {
@@ -85,6 +73,12 @@ void Anitomy::RemoveIgnoredStrings(string_t& filename) const {
   }
 }
 
+// Elements that were found along the way are kept until the end of the
+// parse, because whether they were found matters to the stages after them
+void Anitomy::RemoveUnrequestedElements() {
+  elements_.retain(options_.requested_categories);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Elements& Anitomy::elements() {
@@ -99,4 +93,24 @@ const token_container_t& Anitomy::tokens() const {
   return tokens_;
 }
 
+const KeywordManager& Anitomy::keywords() const {
+  return *keywords_;
+}
+
+void Anitomy::set_keywords(const KeywordManager& keywords) {
+  keywords_ = &keywords;
+}
+
+bool Anitomy::budget_exceeded() const {
+  return budget_.exceeded();
+}
+
+const ParseStats& Anitomy::stats() const {
+  return stats_;
+}
+
+ParseStats& Anitomy::total_stats() {
+  return total_stats_;
+}
+
 }  // namespace anitomy
\ No newline at end of file
@@ -19,30 +19,237 @@
 #ifndef ANITOMY_ANITOMY_H
 #define ANITOMY_ANITOMY_H
 
+#include "budget.h"
 #include "element.h"
+#include "keyword.h"
 #include "options.h"
+#include "parser.h"
+#include "probes.h"
+#include "profile.h"
+#include "stats.h"
 #include "string.h"
 #include "token.h"
+#include "tokenizer.h"
 
 namespace anitomy {
 
 class Anitomy {
 public:
-  bool Parse(string_t filename);
+  Anitomy();
+
+  // The filename is copied into a buffer that is kept between parses, so
+  // that a batch of them needs no allocation for it after the first few
+  bool Parse(const string_t& filename);
+
+  // Uses a profile instead of the parse_* flags and allowed_delimiters of
+  // Options (see profile.h)
+  template <class Profile>
+  bool Parse(const string_t& filename, const Profile& profile);
+
+  // Parses a filename from the caller's buffer, which need not be a string_t
+  bool Parse(StringView filename);
+  template <class Profile>
+  bool Parse(StringView filename, const Profile& profile);
+
+  // Passes the elements of the requested categories to the sink as soon as
+  // they are decided, instead of keeping them in elements()
+  bool ParseInto(const string_t& filename, ElementSink& sink);
+  template <class Profile>
+  bool ParseInto(const string_t& filename, ElementSink& sink,
+                 const Profile& profile);
+  bool ParseInto(StringView filename, ElementSink& sink);
+  template <class Profile>
+  bool ParseInto(StringView filename, ElementSink& sink,
+                 const Profile& profile);
 
   Elements& elements();
   Options& options();
   const token_container_t& tokens() const;
 
+  // The keywords to parse with, keyword_manager by default. They are only
+  // read, so one KeywordManager can be shared by any number of Anitomy
+  // objects on any threads, as long as nothing is added to it meanwhile. It
+  // must outlive the objects that use it.
+  const KeywordManager& keywords() const;
+  void set_keywords(const KeywordManager& keywords);
+
+  // Whether the last parse ran out of its work budget (see Options). Parse
+  // then returns false, with whatever elements were found until then.
+  bool budget_exceeded() const;
+
+  // Per-stage timings of the last parse, and of every parse since the
+  // object was created. Empty unless built with ANITOMY_ENABLE_STATS.
+  const ParseStats& stats() const;
+  ParseStats& total_stats();
+
 private:
-  bool RemoveExtensionFromFilename(string_t& filename, string_t& extension) const;
+  template <class Profile>
+  bool ParseBuffer(const Profile& profile);
+  template <class Profile>
+  bool ParseFilename(string_t& filename, const Profile& profile);
+  size_t FindExtension(const string_t& filename) const;
   void RemoveIgnoredStrings(string_t& filename) const;
+  void RemoveUnrequestedElements();
 
   Elements elements_;
+  const KeywordManager* keywords_;
+  string_t filename_;  // Elements refer to it, reused between parses
+  string_t normalized_filename_;  // Or to this, see Options::normalize_width
   Options options_;
   token_container_t tokens_;
+  WorkBudget budget_;
+  ParseStats stats_;
+  ParseStats total_stats_;
 };
 
+// An Anitomy that always parses with the given profile, e.g.
+// BasicAnitomy<DefaultProfile>. If the profile is fixed at compile time, so
+// is every stage that it disables.
+template <class Profile>
+class BasicAnitomy : public Anitomy {
+public:
+  bool Parse(const string_t& filename) {
+    return Anitomy::Parse(filename, profile_);
+  }
+
+  bool Parse(StringView filename) {
+    return Anitomy::Parse(filename, profile_);
+  }
+
+  bool ParseInto(const string_t& filename, ElementSink& sink) {
+    return Anitomy::ParseInto(filename, sink, profile_);
+  }
+
+  bool ParseInto(StringView filename, ElementSink& sink) {
+    return Anitomy::ParseInto(filename, sink, profile_);
+  }
+
+  Profile& profile() { return profile_; }
+
+private:
+  Profile profile_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <class Profile>
+bool Anitomy::Parse(const string_t& filename, const Profile& profile) {
+  return Parse(StringView(filename.data(), filename.size()), profile);
+}
+
+template <class Profile>
+bool Anitomy::Parse(StringView filename, const Profile& profile) {
+  filename_.assign(filename.data, filename.size);
+  return ParseBuffer(profile);
+}
+
+template <class Profile>
+bool Anitomy::ParseBuffer(const Profile& profile) {
+#if ANITOMY_ENABLE_PROBES
+  // The filename loses its extension during the parse
+  const size_t filename_length = filename_.size();
+#endif
+  ANITOMY_PROBE1(parse__start, filename_length);
+
+#if ANITOMY_ENABLE_STATS
+  stats_.clear();
+  AllocationCounters& counters = GetAllocationCounters();
+  const long long live_bytes = counters.live_bytes;
+  counters.peak_live_bytes = live_bytes;
+  bool result;
+  {
+    ANITOMY_TIME_STAGE(&stats_, kParseStageTotal);
+    result = ParseFilename(filename_, profile);
+  }
+  stats_.peak_live_bytes = counters.peak_live_bytes - live_bytes;
+  stats_.parses = 1;
+  total_stats_.Add(stats_);
+#else
+  const bool result = ParseFilename(filename_, profile);
+#endif
+
+  if (options_.requested_categories != kElementCategoryMaskAll)
+    RemoveUnrequestedElements();
+
+  ANITOMY_PROBE2(parse__done, filename_length, static_cast<int>(result));
+  return result;
+}
+
+template <class Profile>
+bool Anitomy::ParseInto(const string_t& filename, ElementSink& sink,
+                        const Profile& profile) {
+  return ParseInto(StringView(filename.data(), filename.size()), sink,
+                   profile);
+}
+
+template <class Profile>
+bool Anitomy::ParseInto(StringView filename, ElementSink& sink,
+                        const Profile& profile) {
+  elements_.set_sink(&sink, options_.requested_categories);
+  filename_.assign(filename.data, filename.size);
+  const bool result = ParseBuffer(profile);
+  elements_.set_sink(NULL, kElementCategoryMaskAll);
+  return result;
+}
+
+template <class Profile>
+bool Anitomy::ParseFilename(string_t& filename, const Profile& profile) {
+  elements_.clear();
+  elements_.set_source(&filename_);
+  tokens_.clear();
+
+  budget_.Reset(options_.max_work, options_.max_nanoseconds);
+  WorkBudget* budget = budget_.enabled() ? &budget_ : NULL;
+
+  if (profile.parse_file_extension()) {
+    ANITOMY_TIME_STAGE(&stats_, kParseStageRemoveExtension);
+    const size_t position = FindExtension(filename);
+    if (position != string_t::npos) {
+      if (options_.requested_categories &
+          ElementCategoryMask(kElementFileExtension))
+        elements_.insert(kElementFileExtension, filename.data() + position + 1,
+                         filename.size() - position - 1);
+      filename.resize(position);
+    }
+  }
+
+  if (!options_.ignored_strings.empty()) {
+    ANITOMY_TIME_STAGE(&stats_, kParseStageRemoveIgnoredStrings);
+    RemoveIgnoredStrings(filename);
+    if (budget && !budget->Spend(options_.ignored_strings.size()))
+      return false;
+  }
+
+  if (filename.empty())
+    return false;
+  if (options_.requested_categories & ElementCategoryMask(kElementFileName))
+    elements_.insert(kElementFileName, TokenRange(0, filename.size()));
+
+  // The file name keeps the original characters. Every other element refers
+  // to the normalized copy, which has the same offsets.
+  string_t* text = &filename;
+  if (options_.normalize_width) {
+    ANITOMY_TIME_STAGE(&stats_, kParseStageNormalizeWidth);
+    if (FindWidthVariant(filename.data(), filename.size()) != string_t::npos) {
+      normalized_filename_ = filename;
+      NormalizeWidth(normalized_filename_);
+      elements_.set_source(&normalized_filename_);
+      text = &normalized_filename_;
+    }
+  }
+
+  Tokenizer tokenizer(*text, elements_, options_, *keywords_, tokens_, &stats_,
+                      budget);
+  if (!tokenizer.Tokenize(profile) || budget_.exceeded())
+    return false;
+
+  Parser parser(elements_, options_, *keywords_, tokens_, &stats_, budget);
+  if (!parser.Parse(profile))
+    return false;
+
+  return true;
+}
+
 }  // namespace anitomy
 
 #endif  // ANITOMY_ANITOMY_H
\ No newline at end of file
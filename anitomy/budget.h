@@ -0,0 +1,74 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ANITOMY_BUDGET_H
+#define ANITOMY_BUDGET_H
+
+#include <cstddef>
+
+#include "stats.h"
+
+namespace anitomy {
+
+// Limits the work of a single parse, so that a pathological filename can't
+// stall the caller. Work is counted in steps, roughly one per token visited;
+// the deadline is checked every kClockInterval steps, so that the clock is
+// rarely read. Once exceeded, every further Spend() fails, and the parse
+// stops at the next safe point with what it has found so far.
+class WorkBudget {
+public:
+  WorkBudget() : steps_(0), max_steps_(0), deadline_(0), exceeded_(false) {}
+
+  // Zero means no limit
+  void Reset(size_t max_steps, unsigned long long max_nanoseconds) {
+    steps_ = 0;
+    max_steps_ = max_steps;
+    deadline_ = max_nanoseconds ? GetStatsClock() + max_nanoseconds : 0;
+    exceeded_ = false;
+  }
+
+  bool Spend(size_t steps) {
+    if (exceeded_)
+      return false;
+    const size_t previous_steps = steps_;
+    steps_ += steps;
+    if (max_steps_ && steps_ > max_steps_) {
+      exceeded_ = true;
+    } else if (deadline_ &&
+               previous_steps / kClockInterval != steps_ / kClockInterval &&
+               GetStatsClock() > deadline_) {
+      exceeded_ = true;
+    }
+    return !exceeded_;
+  }
+
+  bool enabled() const { return max_steps_ || deadline_; }
+  bool exceeded() const { return exceeded_; }
+  size_t steps() const { return steps_; }
+
+private:
+  static const size_t kClockInterval = 64;
+
+  size_t steps_;
+  size_t max_steps_;
+  unsigned long long deadline_;
+  bool exceeded_;
+};
+
+}  // namespace anitomy
+
+#endif  // ANITOMY_BUDGET_H
\ No newline at end of file
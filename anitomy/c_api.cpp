@@ -0,0 +1,156 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <new>
+
+#include "anitomy.h"
+#include "c_api.h"
+#include "string.h"
+
+using namespace anitomy;
+
+// The C enumeration must follow ElementCategory
+typedef char check_first_category[
+    static_cast<int>(ANITOMY_ELEMENT_ANIME_SEASON) ==
+    static_cast<int>(kElementAnimeSeason) ? 1 : -1];
+typedef char check_last_category[
+    static_cast<int>(ANITOMY_ELEMENT_VIDEO_TERM) + 1 ==
+    static_cast<int>(kElementIterateLast) ? 1 : -1];
+
+struct anitomy_parser {
+  Anitomy anitomy;
+  string_t filename;  // Decoded from UTF-8, reused between parses
+};
+
+// Writes the elements of the last parse after the ones that are already in
+// the buffers. If they don't fit, returns false, and element_count and
+// arena_used are what the buffers would need.
+static bool WriteElements(const Elements& parsed,
+                          anitomy_element* elements, size_t max_elements,
+                          size_t& element_count,
+                          char* arena, size_t arena_size, size_t& arena_used) {
+  bool fits = element_count + parsed.size() <= max_elements;
+
+  for (size_t i = 0; i < parsed.size(); ++i) {
+    const size_t available = fits ? arena_size - arena_used : 0;
+    const size_t length = StringToUtf8(parsed.data(i), parsed.length(i),
+                                       fits ? arena + arena_used : NULL,
+                                       available);
+    if (length > available)
+      fits = false;
+    if (fits) {
+      anitomy_element& element = elements[element_count];
+      element.category = parsed.category(i);
+      element.offset = arena_used;
+      element.length = length;
+    }
+    ++element_count;
+    arena_used += length;
+  }
+
+  return fits;
+}
+
+static bool ParseUtf8(anitomy_parser* parser, const char* filename,
+                      size_t length) {
+  Utf8ToString(filename, length, parser->filename);
+  return parser->anitomy.Parse(StringView(parser->filename.data(),
+                                          parser->filename.size()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+anitomy_parser* anitomy_create(void) {
+  return new (std::nothrow) anitomy_parser;
+}
+
+void anitomy_destroy(anitomy_parser* parser) {
+  delete parser;
+}
+
+void anitomy_set_requested_categories(anitomy_parser* parser,
+                                      unsigned long mask) {
+  if (parser)
+    parser->anitomy.options().requested_categories =
+        mask & kElementCategoryMaskAll;
+}
+
+int anitomy_parse_utf8(anitomy_parser* parser,
+                       const char* filename, size_t length,
+                       anitomy_element* elements, size_t max_elements,
+                       size_t* element_count,
+                       char* arena, size_t arena_size, size_t* arena_used) {
+  if (!parser || (!filename && length) || !element_count || !arena_used)
+    return ANITOMY_ERROR;
+
+  try {
+    const bool result = ParseUtf8(parser, filename, length);
+    *element_count = 0;
+    *arena_used = 0;
+    if (!WriteElements(parser->anitomy.elements(), elements, max_elements,
+                       *element_count, arena, arena_size, *arena_used))
+      return ANITOMY_BUFFER_TOO_SMALL;
+    return result ? ANITOMY_OK : ANITOMY_NOT_PARSED;
+  } catch (...) {  // Nothing may be thrown through C
+    return ANITOMY_ERROR;
+  }
+}
+
+size_t anitomy_parse_batch_utf8(anitomy_parser* parser,
+                                const char* const* filenames,
+                                const size_t* lengths, size_t count,
+                                anitomy_result* results,
+                                anitomy_element* elements,
+                                size_t max_elements,
+                                char* arena, size_t arena_size,
+                                size_t* arena_used) {
+  if (!parser || !filenames || !lengths || !results || !arena_used)
+    return 0;
+
+  size_t element_count = 0;
+  *arena_used = 0;
+
+  size_t i = 0;
+  size_t first_byte = 0;
+  try {
+    for (; i < count; ++i) {
+      const size_t first_element = element_count;
+      first_byte = *arena_used;
+      if (!filenames[i] && lengths[i]) {
+        results[i].status = ANITOMY_ERROR;
+        results[i].first_element = first_element;
+        results[i].element_count = 0;
+        continue;
+      }
+      const bool result = ParseUtf8(parser, filenames[i], lengths[i]);
+      if (!WriteElements(parser->anitomy.elements(), elements, max_elements,
+                         element_count, arena, arena_size, *arena_used)) {
+        *arena_used = first_byte;
+        return i;
+      }
+      results[i].status = result ? ANITOMY_OK : ANITOMY_NOT_PARSED;
+      results[i].first_element = first_element;
+      results[i].element_count = element_count - first_element;
+    }
+  } catch (...) {  // Nothing may be thrown through C
+    *arena_used = first_byte;
+    return i;
+  }
+
+  return count;
+}
\ No newline at end of file
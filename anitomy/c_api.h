@@ -0,0 +1,128 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_C_API_H
+#define ANITOMY_C_API_H
+
+/* A C interface for bindings (ctypes, cgo, etc.). Filenames go in as UTF-8,
+   and results are written into buffers of the caller: an array of elements,
+   each of which is a category and a range of an arena that holds the values
+   as UTF-8. Nothing is allocated for the results, and a parser keeps its
+   buffers between calls.
+
+   A parser must not be used by two threads at the same time. */
+
+#include <stddef.h>
+
+#ifndef ANITOMY_C_API  /* e.g. __declspec(dllexport) when building a DLL */
+#define ANITOMY_C_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The same values as anitomy::ElementCategory */
+enum anitomy_element_category {
+  ANITOMY_ELEMENT_ANIME_SEASON,
+  ANITOMY_ELEMENT_ANIME_SEASON_PREFIX,
+  ANITOMY_ELEMENT_ANIME_TITLE,
+  ANITOMY_ELEMENT_ANIME_TYPE,
+  ANITOMY_ELEMENT_ANIME_YEAR,
+  ANITOMY_ELEMENT_AUDIO_TERM,
+  ANITOMY_ELEMENT_DEVICE_COMPATIBILITY,
+  ANITOMY_ELEMENT_EPISODE_NUMBER,
+  ANITOMY_ELEMENT_EPISODE_PREFIX,
+  ANITOMY_ELEMENT_EPISODE_TITLE,
+  ANITOMY_ELEMENT_FILE_CHECKSUM,
+  ANITOMY_ELEMENT_FILE_EXTENSION,
+  ANITOMY_ELEMENT_FILE_NAME,
+  ANITOMY_ELEMENT_LANGUAGE,
+  ANITOMY_ELEMENT_OTHER,
+  ANITOMY_ELEMENT_RELEASE_GROUP,
+  ANITOMY_ELEMENT_RELEASE_INFORMATION,
+  ANITOMY_ELEMENT_RELEASE_VERSION,
+  ANITOMY_ELEMENT_SOURCE,
+  ANITOMY_ELEMENT_SUBTITLES,
+  ANITOMY_ELEMENT_VIDEO_RESOLUTION,
+  ANITOMY_ELEMENT_VIDEO_TERM
+};
+
+enum anitomy_status {
+  ANITOMY_OK,
+  ANITOMY_NOT_PARSED,        /* Parse returned false; elements are written */
+  ANITOMY_BUFFER_TOO_SMALL,  /* The buffers hold no results */
+  ANITOMY_ERROR              /* Invalid arguments, or out of memory */
+};
+
+typedef struct anitomy_parser anitomy_parser;
+
+typedef struct anitomy_element {
+  int category;   /* anitomy_element_category */
+  size_t offset;  /* Into the arena */
+  size_t length;  /* In bytes */
+} anitomy_element;
+
+typedef struct anitomy_result {
+  int status;            /* ANITOMY_OK, ANITOMY_NOT_PARSED, or ANITOMY_ERROR
+                            for a NULL filename with a length */
+  size_t first_element;  /* Into the elements */
+  size_t element_count;
+} anitomy_result;
+
+/* Returns NULL if out of memory */
+ANITOMY_C_API anitomy_parser* anitomy_create(void);
+ANITOMY_C_API void anitomy_destroy(anitomy_parser* parser);
+
+/* One bit for each anitomy_element_category, as in Options */
+ANITOMY_C_API void anitomy_set_requested_categories(anitomy_parser* parser,
+                                                    unsigned long mask);
+
+/* Parses a filename and writes its elements, with their values from the
+   start of the arena. If the elements or their values do not fit,
+   returns ANITOMY_BUFFER_TOO_SMALL, and element_count and arena_used are
+   set to the sizes that they need. */
+ANITOMY_C_API int anitomy_parse_utf8(anitomy_parser* parser,
+                                     const char* filename, size_t length,
+                                     anitomy_element* elements,
+                                     size_t max_elements,
+                                     size_t* element_count,
+                                     char* arena, size_t arena_size,
+                                     size_t* arena_used);
+
+/* Parses filenames in order, with one result each, until the elements or
+   the arena are full. Returns the number of filenames whose results were
+   written; the caller continues from there with emptied buffers. A
+   filename that fits in no buffer is not written, so a return value of 0
+   for count > 0 means that the buffers are too small for the first one.
+   If memory runs out, the batch stops after the results written so far. */
+ANITOMY_C_API size_t anitomy_parse_batch_utf8(anitomy_parser* parser,
+                                              const char* const* filenames,
+                                              const size_t* lengths,
+                                              size_t count,
+                                              anitomy_result* results,
+                                              anitomy_element* elements,
+                                              size_t max_elements,
+                                              char* arena, size_t arena_size,
+                                              size_t* arena_used);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* ANITOMY_C_API_H */
\ No newline at end of file
@@ -0,0 +1,355 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_CASE_TABLE_H
+#define ANITOMY_CASE_TABLE_H
+
+// Simple case mappings of Latin-1, Latin Extended-A and B, Greek, Cyrillic,
+// Latin Extended Additional and fullwidth forms, from Unicode 14.0, for
+// string.cpp. Each page of 256 characters that has a mapping has a row of
+// indexes into the deltas, which are added to a character to map it.
+//
+// Characters that would map into ASCII (e.g. U+017F to "S") are left out,
+// so that non-ASCII words never match ASCII keywords. ASCII itself is mapped
+// in string.cpp without the tables.
+
+namespace anitomy {
+
+// Returns the row of the page of the character, or -1 if it has none
+inline int GetCasePage(unsigned long c) {
+  switch (c >> 8) {
+    case 0x00: return 0;
+    case 0x01: return 1;
+    case 0x02: return 2;
+    case 0x03: return 3;
+    case 0x04: return 4;
+    case 0x05: return 5;
+    case 0x1E: return 6;
+    case 0xFF: return 7;
+  }
+  return -1;
+}
+
+static const short upper_deltas[] = {
+  0, -116, -96, -86, -80, -79, -64, -63, -62, -59, -57, -54, -47, -38, -37,
+  -32, -31, -15, -8, -2, -1, 7, 56, 97, 121, 130, 163, 195, 743, 10815,
+};
+
+static const unsigned char upper_indexes[][256] = {
+  {  // U+0000
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0, 28,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15,  0, 15, 15, 15, 15, 15, 15, 15, 24,
+  },
+  {  // U+0100
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0,  0,  0, 20,  0, 20,  0, 20,  0,  0, 20,  0, 20,  0, 20,  0,
+    20,  0, 20,  0, 20,  0, 20,  0, 20,  0,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0,  0, 20,  0, 20,  0, 20,  0,
+    27,  0,  0, 20,  0, 20,  0,  0, 20,  0,  0,  0, 20,  0,  0,  0,
+     0,  0, 20,  0,  0, 23,  0,  0,  0, 20, 26,  0,  0,  0, 25,  0,
+     0, 20,  0, 20,  0, 20,  0,  0, 20,  0,  0,  0,  0, 20,  0,  0,
+    20,  0,  0,  0, 20,  0, 20,  0,  0, 20,  0,  0,  0, 20,  0, 22,
+     0,  0,  0,  0,  0, 20, 19,  0, 20, 19,  0, 20, 19,  0, 20,  0,
+    20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  5,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0,  0, 20, 19,  0, 20,  0,  0,  0, 20,  0, 20,  0, 20,  0, 20,
+  },
+  {  // U+0200
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0,  0,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0,  0,  0,  0,  0,  0,  0,  0, 20,  0,  0, 29,
+    29,  0, 20,  0,  0,  0,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  },
+  {  // U+0300
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0, 20,  0, 20,  0,  0,  0, 20,  0,  0,  0, 25, 25, 25,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 13, 14, 14, 14,
+     0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 16, 15, 15, 15, 15, 15, 15, 15, 15, 15,  6,  7,  7,  0,
+     8, 10,  0,  0,  0, 12, 11, 18,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     3,  4, 21,  1,  0,  2,  0,  0, 20,  0,  0, 20,  0,  0,  0,  0,
+  },
+  {  // U+0400
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+     4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0,  0,  0,  0,  0,  0,  0,  0,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20, 17,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+  },
+  {  // U+0500
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  },
+  {  // U+1E00
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0,  0,  0,  0,  0,  9,  0,  0,  0,  0,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+     0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,  0, 20,
+  },
+  {  // U+FF00
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  },
+};
+
+static const short lower_deltas[] = {
+  0, -7615, -195, -163, -130, -121, -97, -60, -56, -7, 1, 2, 8, 15, 32, 37, 38,
+  63, 64, 69, 71, 79, 80, 116, 202, 203, 205, 206, 207, 209, 210, 211, 213,
+  214, 217, 218, 219, 10792, 10795,
+};
+
+static const unsigned char lower_indexes[][256] = {
+  {  // U+0000
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+    14, 14, 14, 14, 14, 14, 14,  0, 14, 14, 14, 14, 14, 14, 14,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  },
+  {  // U+0100
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+     0,  0, 10,  0, 10,  0, 10,  0,  0, 10,  0, 10,  0, 10,  0, 10,
+     0, 10,  0, 10,  0, 10,  0, 10,  0,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0,  5, 10,  0, 10,  0, 10,  0,  0,
+     0, 30, 10,  0, 10,  0, 27, 10,  0, 26, 26, 10,  0,  0, 21, 24,
+    25, 10,  0, 26, 28,  0, 31, 29, 10,  0,  0,  0, 31, 32,  0, 33,
+    10,  0, 10,  0, 10,  0, 35, 10,  0, 35,  0,  0, 10,  0, 35, 10,
+     0, 34, 34, 10,  0, 10,  0, 36, 10,  0,  0,  0, 10,  0,  0,  0,
+     0,  0,  0,  0, 11, 10,  0, 11, 10,  0, 11, 10,  0, 10,  0, 10,
+     0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+     0, 11, 10,  0, 10,  0,  6,  8, 10,  0, 10,  0, 10,  0, 10,  0,
+  },
+  {  // U+0200
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+     4,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0,  0,  0,  0,  0,  0,  0, 38, 10,  0,  3, 37,  0,
+     0, 10,  0,  2, 19, 20, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  },
+  {  // U+0300
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    10,  0, 10,  0,  0,  0, 10,  0,  0,  0,  0,  0,  0,  0,  0, 23,
+     0,  0,  0,  0,  0,  0, 16,  0, 15, 15, 15,  0, 18,  0, 17, 17,
+     0, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+    14, 14,  0, 14, 14, 14, 14, 14, 14, 14, 14, 14,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 12,
+     0,  0,  0,  0,  0,  0,  0,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+     0,  0,  0,  0,  7,  0,  0, 10,  0,  9, 10,  0,  0,  4,  4,  4,
+  },
+  {  // U+0400
+    22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+    14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+    14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0,  0,  0,  0,  0,  0,  0,  0,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    13, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+  },
+  {  // U+0500
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  },
+  {  // U+1E00
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+    10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0, 10,  0,
+  },
+  {  // U+FF00
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+    14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+  },
+};
+
+}  // namespace anitomy
+
+#endif  // ANITOMY_CASE_TABLE_H
\ No newline at end of file
@@ -23,6 +23,57 @@
 
 namespace anitomy {
 
+Elements::Elements()
+    : source_(NULL),
+      materialized_(true),
+      sink_(NULL),
+      sink_categories_(kElementCategoryMaskAll),
+      found_categories_(0) {
+}
+
+// The copy reads the source of the original, but doesn't change it. It
+// starts without a sink, since the sink of the original may be gone by the
+// time the copy is used.
+Elements::Elements(const Elements& elements)
+    : elements_(elements.elements_),
+      ranges_(elements.ranges_),
+      source_(elements.source_),
+      materialized_(elements.materialized_),
+      sink_(NULL),
+      sink_categories_(0),
+      found_categories_(0) {
+  Materialize();
+  source_ = NULL;
+}
+
+Elements& Elements::operator=(const Elements& elements) {
+  if (this != &elements) {
+    elements_ = elements.elements_;
+    ranges_ = elements.ranges_;
+    source_ = elements.source_;
+    materialized_ = elements.materialized_;
+    sink_ = NULL;
+    sink_categories_ = 0;
+    found_categories_ = 0;
+    Materialize();
+    source_ = NULL;
+  }
+  return *this;
+}
+
+// Copies the values that are still ranges of the source
+void Elements::Materialize() const {
+  if (materialized_)
+    return;
+  for (size_t i = 0; source_ && i < elements_.size(); ++i)
+    if (elements_[i].second.empty())
+      elements_[i].second.assign(*source_, ranges_[i].offset,
+                                 ranges_[i].size);
+  materialized_ = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool Elements::empty() const {
   return elements_.empty();
 }
@@ -34,44 +85,54 @@ size_t Elements::size() const {
 ////////////////////////////////////////////////////////////////////////////////
 
 element_iterator_t Elements::begin() {
+  Materialize();
   return elements_.begin();
 }
 
 element_const_iterator_t Elements::begin() const {
+  Materialize();
   return elements_.begin();
 }
 
 element_const_iterator_t Elements::cbegin() const {
+  Materialize();
   return elements_.begin();
 }
 
 element_iterator_t Elements::end() {
+  Materialize();
   return elements_.end();
 }
 
 element_const_iterator_t Elements::end() const {
+  Materialize();
   return elements_.end();
 }
 
 element_const_iterator_t Elements::cend() const {
+  Materialize();
   return elements_.end();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 element_pair_t& Elements::at(size_t position) {
+  Materialize();
   return elements_.at(position);
 }
 
 const element_pair_t& Elements::at(size_t position) const {
+  Materialize();
   return elements_.at(position);
 }
 
 element_pair_t& Elements::operator[](size_t position) {
+  Materialize();
   return elements_[position];
 }
 
 const element_pair_t& Elements::operator[](size_t position) const {
+  Materialize();
   return elements_[position];
 }
 
@@ -91,6 +152,7 @@ const string_t& Elements::get(ElementCategory category) {
 }
 
 std::vector<string_t> Elements::get_all(ElementCategory category) const {
+  Materialize();
   std::vector<string_t> elements;
 
   for (element_container_t::const_iterator element = elements_.begin(); element != elements_.end(); ++element)
@@ -100,15 +162,77 @@ std::vector<string_t> Elements::get_all(ElementCategory category) const {
   return elements;
 }
 
+ElementCategory Elements::category(size_t position) const {
+  return elements_.at(position).first;
+}
+
+const char_t* Elements::data(size_t position) const {
+  const string_t& value = elements_.at(position).second;
+  if (value.empty() && source_)
+    return source_->data() + ranges_[position].offset;
+  return value.data();
+}
+
+size_t Elements::length(size_t position) const {
+  const string_t& value = elements_.at(position).second;
+  return value.empty() && source_ ? ranges_[position].size : value.size();
+}
+
+bool Elements::get_range(size_t position, TokenRange& range) const {
+  range = ranges_.at(position);
+  return range.offset != string_t::npos;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void Elements::clear() {
   elements_.clear();
+  ranges_.clear();
+  materialized_ = true;
+  found_categories_ = 0;
 }
 
 void Elements::insert(ElementCategory category, const string_t& value) {
-  if (!value.empty())
-    elements_.push_back(std::make_pair(category, value));
+  insert(category, value.data(), value.size());
+}
+
+void Elements::insert(ElementCategory category, const char_t* value,
+                      size_t length) {
+  if (length == 0)
+    return;
+  if (sink_) {
+    found_categories_ |= ElementCategoryMask(category);
+    if (sink_categories_ & ElementCategoryMask(category))
+      sink_->OnElement(category, value, length);
+    return;
+  }
+  elements_.push_back(std::make_pair(category, string_t(value, length)));
+  ranges_.push_back(TokenRange(string_t::npos, length));
+}
+
+void Elements::insert(ElementCategory category, const TokenRange& range) {
+  if (range.size == 0 || !source_)
+    return;
+  if (sink_) {
+    insert(category, source_->data() + range.offset, range.size);
+    return;
+  }
+  elements_.push_back(std::make_pair(category, string_t()));
+  ranges_.push_back(range);
+  materialized_ = false;
+}
+
+// Keeps only the range if the value is the same
+void Elements::insert(ElementCategory category, const string_t& value,
+                      const TokenRange& range) {
+  if (source_ && range.offset != string_t::npos &&
+      source_->compare(range.offset, range.size, value) == 0) {
+    insert(category, range);
+  } else if (!value.empty()) {
+    insert(category, value);
+    if (!sink_)
+      ranges_.back() = range;
+  }
 }
 
 bool is_category(const element_pair_t element, const ElementCategory category)
@@ -117,14 +241,38 @@ bool is_category(const element_pair_t element, const ElementCategory category)
 }
 
 void Elements::erase(ElementCategory category) {
-  element_container_t::iterator iterator = std::remove_if(elements_.begin(), elements_.end(), std::bind2nd(std::ptr_fun(is_category), category));
-  elements_.erase(iterator, elements_.end());
+  for (size_t i = elements_.size(); i-- > 0;) {
+    if (elements_[i].first == category) {
+      elements_.erase(elements_.begin() + i);
+      ranges_.erase(ranges_.begin() + i);
+    }
+  }
 }
 
 element_iterator_t Elements::erase(element_iterator_t iterator) {
+  ranges_.erase(ranges_.begin() + (iterator - elements_.begin()));
   return elements_.erase(iterator);
 }
 
+void Elements::retain(element_category_mask_t categories) {
+  size_t kept = 0;
+  while (kept < elements_.size() &&
+         (categories & ElementCategoryMask(elements_[kept].first)))
+    ++kept;
+
+  for (size_t i = kept + 1; i < elements_.size(); ++i) {
+    if (categories & ElementCategoryMask(elements_[i].first)) {
+      elements_[kept].first = elements_[i].first;
+      elements_[kept].second.swap(elements_[i].second);
+      ranges_[kept] = ranges_[i];
+      ++kept;
+    }
+  }
+
+  elements_.resize(kept);
+  ranges_.resize(kept);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 size_t Elements::count(ElementCategory category) const {
@@ -132,15 +280,43 @@ size_t Elements::count(ElementCategory category) const {
 }
 
 bool Elements::empty(ElementCategory category) const {
-  return find(category) == elements_.end();
+  if (sink_)
+    return (found_categories_ & ElementCategoryMask(category)) == 0;
+  return std::find_if(elements_.begin(), elements_.end(), std::bind2nd(std::ptr_fun(is_category), category)) == elements_.end();
 }
 
 element_iterator_t Elements::find(ElementCategory category) {
+  Materialize();
   return std::find_if(elements_.begin(), elements_.end(), std::bind2nd(std::ptr_fun(is_category), category));
 }
 
 element_const_iterator_t Elements::find(ElementCategory category) const {
+  Materialize();
   return std::find_if(elements_.begin(), elements_.end(), std::bind2nd(std::ptr_fun(is_category), category));
 }
 
+size_t Elements::memory_usage() const {
+  size_t size = sizeof(*this) + elements_.size() * sizeof(element_pair_t) +
+                ranges_.size() * sizeof(TokenRange);
+
+  for (size_t i = 0; i < elements_.size(); ++i)
+    if (length(i) * sizeof(char_t) >= sizeof(string_t))
+      size += (length(i) + 1) * sizeof(char_t);
+
+  return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Elements::set_sink(ElementSink* sink,
+                        element_category_mask_t categories) {
+  sink_ = sink;
+  sink_categories_ = categories;
+}
+
+void Elements::set_source(const string_t* source) {
+  Materialize();
+  source_ = source;
+}
+
 }  // namespace anitomy
\ No newline at end of file
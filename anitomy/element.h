@@ -22,9 +22,14 @@
 #include <vector>
 
 #include "string.h"
+#include "token.h"
 
 namespace anitomy {
 
+class Anitomy;
+class KeywordManager;
+class Parser;
+
 enum ElementCategory {
   kElementIterateFirst,
   kElementAnimeSeason = kElementIterateFirst,
@@ -53,14 +58,47 @@ enum ElementCategory {
   kElementUnknown = kElementIterateLast
 };
 
+// A set of element categories, with one bit for each category
+typedef unsigned long element_category_mask_t;
+
+const element_category_mask_t kElementCategoryMaskAll =
+    (1UL << kElementIterateLast) - 1;
+
+inline element_category_mask_t ElementCategoryMask(ElementCategory category) {
+  return 1UL << category;
+}
+
 typedef std::pair<ElementCategory, string_t> element_pair_t;
 typedef std::vector<element_pair_t> element_container_t;
 
 typedef element_container_t::iterator element_iterator_t;
 typedef element_container_t::const_iterator element_const_iterator_t;
 
+// Receives elements as soon as the parser decides them, in the same order
+// as they would appear in Elements. The value is only valid during the call:
+// it points into the filename, into a token, or into a scratch buffer.
+class ElementSink {
+public:
+  virtual ~ElementSink() {}
+
+  virtual void OnElement(ElementCategory category, const char_t* value,
+                         size_t length) = 0;
+};
+
+// Most values are a range of the filename that was parsed, and are kept as
+// that range until they are read through an iterator, at() or operator[],
+// so that values which are replaced, removed or only read through data() and
+// length() are never copied. The first such read copies them all, even on
+// const Elements, so the Elements of an Anitomy object are not to be shared
+// between threads; copies have values of their own and can be. Values that
+// are not a range, such as titles whose delimiters were replaced, are strings
+// of their own.
 class Elements {
 public:
+  Elements();
+  Elements(const Elements& elements);
+  Elements& operator=(const Elements& elements);
+
   // Capacity
   bool empty() const;
   size_t size() const;
@@ -82,12 +120,22 @@ public:
   // Value access
   const string_t& get(ElementCategory category);
   std::vector<string_t> get_all(ElementCategory category) const;
+  ElementCategory category(size_t position) const;
+  const char_t* data(size_t position) const;
+  size_t length(size_t position) const;
+
+  // Where the element came from in the filename that was parsed, if known.
+  // The value can still differ from that range, e.g. for a title.
+  bool get_range(size_t position, TokenRange& range) const;
 
   // Modifiers
   void clear();
   void insert(ElementCategory category, const string_t& value);
+  void insert(ElementCategory category, const char_t* value, size_t length);
   void erase(ElementCategory category);
   element_iterator_t erase(element_iterator_t iterator);
+  // Removes the elements of every other category, keeping ranges as they are
+  void retain(element_category_mask_t categories);
 
   // Lookup
   size_t count(ElementCategory category) const;
@@ -95,8 +143,42 @@ public:
   element_iterator_t find(ElementCategory category);
   element_const_iterator_t find(ElementCategory category) const;
 
+  // A lower bound: the pairs and ranges themselves, plus the characters of
+  // values that can't fit in a small-string buffer, as if every value was
+  // copied. Allocator overhead is ignored.
+  size_t memory_usage() const;
+
+  // While a sink is set, inserted elements of the given categories are
+  // passed to it instead of being stored. Only which categories were found
+  // is kept, so that empty(category) still works. Copies have no sink.
+  void set_sink(ElementSink* sink, element_category_mask_t categories);
+
+  // The filename that ranges refer to. It must outlive the elements, or be
+  // replaced before it changes. Replacing it copies the values that are
+  // still ranges of the old one, so set_source(NULL) leaves the elements on
+  // their own.
+  void set_source(const string_t* source);
+
 private:
-  element_container_t elements_;
+  friend class Anitomy;
+  friend class KeywordManager;
+  friend class Parser;
+
+  // Ranges refer to the source, which only the parse sets. Without a source,
+  // a range is not inserted.
+  void insert(ElementCategory category, const TokenRange& range);
+  void insert(ElementCategory category, const string_t& value,
+              const TokenRange& range);
+
+  void Materialize() const;
+
+  mutable element_container_t elements_;
+  std::vector<TokenRange> ranges_;  // Offset is npos if unknown
+  const string_t* source_;
+  mutable bool materialized_;
+  ElementSink* sink_;
+  element_category_mask_t sink_categories_;
+  element_category_mask_t found_categories_;
 };
 
 }  // namespace anitomy
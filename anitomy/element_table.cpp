@@ -0,0 +1,343 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "element_table.h"
+
+namespace anitomy {
+
+const char kElementTableMagic[] = {'A', 'N', 'T', 'B'};
+const unsigned int kElementTableVersion = 1;
+
+static const ElementColumn::offset_t kMaxOffset =
+    std::numeric_limits<ElementColumn::offset_t>::max();
+
+static void AppendUint32(std::string& output, unsigned int value) {
+  output.push_back(static_cast<char>(value & 0xFF));
+  output.push_back(static_cast<char>((value >> 8) & 0xFF));
+  output.push_back(static_cast<char>((value >> 16) & 0xFF));
+  output.push_back(static_cast<char>((value >> 24) & 0xFF));
+}
+
+static bool ReadUint32(std::istream& input, unsigned int& value) {
+  unsigned char bytes[4];
+  if (!input.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+    return false;
+  value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+          (static_cast<unsigned int>(bytes[3]) << 24);
+  return true;
+}
+
+// Offsets start at zero, never decrease, and end at `last`
+static bool ReadOffsets(std::istream& input, size_t count,
+                        ElementColumn::offset_t last,
+                        std::vector<ElementColumn::offset_t>& offsets) {
+  offsets.clear();
+  offsets.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    ElementColumn::offset_t offset = 0;
+    if (!ReadUint32(input, offset))
+      return false;
+    if ((i > 0 && offset < offsets.back()) || offset > last)
+      return false;
+    offsets.push_back(offset);
+  }
+  return count > 0 && offsets.front() == 0 && offsets.back() == last;
+}
+
+static bool ReadBytes(std::istream& input, size_t size, std::string& output) {
+  output.resize(size);
+  return size == 0 || input.read(&output[0], size);
+}
+
+static size_t GetBitmapSize(size_t rows) {
+  return ((rows + 31) / 32) * 4;
+}
+
+static unsigned long long GetRemainingSize(std::istream& input) {
+  const std::streampos position = input.tellg();
+  input.seekg(0, std::ios::end);
+  const std::streampos end = input.tellg();
+  input.seekg(position);
+  if (position == std::streampos(-1) || end < position)
+    return 0;
+  return static_cast<unsigned long long>(end - position);
+}
+
+// The bitmap is redundant, so it must agree with the row offsets, and the
+// bits past the last row must be clear
+static bool CheckValidity(const std::string& validity,
+                          const std::vector<ElementColumn::offset_t>& row_offsets) {
+  const size_t rows = row_offsets.size() - 1;
+  for (size_t row = 0; row < (rows + 7) / 8 * 8; ++row) {
+    const bool valid = row < rows && row_offsets[row + 1] > row_offsets[row];
+    const bool bit = (validity[row / 8] & (1 << (row % 8))) != 0;
+    if (bit != valid)
+      return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ElementColumn::ElementColumn() {
+  value_offsets_.push_back(0);
+  row_offsets_.push_back(0);
+}
+
+size_t ElementColumn::value_count() const {
+  return value_offsets_.size() - 1;
+}
+
+ElementValueView ElementColumn::value(size_t index) const {
+  return ElementValueView(arena_.data() + value_offsets_[index],
+                          value_offsets_[index + 1] - value_offsets_[index]);
+}
+
+size_t ElementColumn::row_begin(size_t row) const {
+  return row_offsets_[row];
+}
+
+size_t ElementColumn::row_end(size_t row) const {
+  return row_offsets_[row + 1];
+}
+
+bool ElementColumn::is_valid(size_t row) const {
+  return (validity_[row / 8] & (1 << (row % 8))) != 0;
+}
+
+size_t ElementColumn::memory_usage() const {
+  return arena_.capacity() +
+         value_offsets_.capacity() * sizeof(offset_t) +
+         row_offsets_.capacity() * sizeof(offset_t) +
+         validity_.capacity();
+}
+
+void ElementColumn::AppendRow() {
+  const size_t row = row_offsets_.size() - 1;
+  if (row % 8 == 0)
+    validity_.push_back(0);
+  if (value_count() > row_offsets_.back())
+    validity_.back() |= 1 << (row % 8);
+  row_offsets_.push_back(static_cast<offset_t>(value_count()));
+}
+
+bool ElementColumn::AppendValue(const std::string& value) {
+  if (value.size() > kMaxOffset - arena_.size() ||
+      value_count() >= kMaxOffset)
+    return false;
+  arena_.append(value);
+  value_offsets_.push_back(static_cast<offset_t>(arena_.size()));
+  return true;
+}
+
+void ElementColumn::DiscardValues() {
+  value_offsets_.resize(row_offsets_.back() + 1);
+  arena_.resize(value_offsets_.back());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ElementTable::ElementTable()
+    : rows_(0) {
+}
+
+bool ElementTable::Append(const Elements& elements) {
+  // The row count is written as 32 bits as well
+  if (rows_ >= kMaxOffset)
+    return false;
+
+  for (element_const_iterator_t element = elements.begin(); element != elements.end(); ++element) {
+    if (element->first < kElementIterateLast &&
+        !columns_[element->first].AppendValue(StringToUtf8(element->second))) {
+      for (int i = kElementIterateFirst; i < kElementIterateLast; ++i)
+        columns_[i].DiscardValues();
+      return false;
+    }
+  }
+
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i)
+    columns_[i].AppendRow();
+
+  ++rows_;
+  return true;
+}
+
+void ElementTable::clear() {
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i)
+    columns_[i] = ElementColumn();
+  rows_ = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ElementTable::empty() const {
+  return rows_ == 0;
+}
+
+size_t ElementTable::rows() const {
+  return rows_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const ElementColumn& ElementTable::column(ElementCategory category) const {
+  return columns_[category];
+}
+
+ElementValueView ElementTable::get(size_t row,
+                                   ElementCategory category) const {
+  const ElementColumn& column = columns_[category];
+  if (!column.is_valid(row))
+    return ElementValueView();
+  return column.value(column.row_begin(row));
+}
+
+size_t ElementTable::count(size_t row, ElementCategory category) const {
+  const ElementColumn& column = columns_[category];
+  return column.row_end(row) - column.row_begin(row);
+}
+
+// Elements come back grouped by category, rather than in the order in which
+// the parser found them.
+Elements ElementTable::row(size_t row) const {
+  Elements elements;
+
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+    const ElementColumn& column = columns_[i];
+    for (size_t j = column.row_begin(row); j < column.row_end(row); ++j)
+      elements.insert(static_cast<ElementCategory>(i),
+                      Utf8ToString(column.value(j).str()));
+  }
+
+  return elements;
+}
+
+size_t ElementTable::memory_usage() const {
+  size_t size = sizeof(*this);
+
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i)
+    size += columns_[i].memory_usage();
+
+  return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ElementTable::Export(const std::string& path) const {
+  std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+  if (!file)
+    return false;
+
+  std::string buffer(kElementTableMagic, sizeof(kElementTableMagic));
+  AppendUint32(buffer, kElementTableVersion);
+  AppendUint32(buffer, static_cast<unsigned int>(rows_));
+  AppendUint32(buffer, kElementIterateLast);
+  file.write(buffer.data(), buffer.size());
+
+  // Columns are written one at a time to keep the buffer small
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+    const ElementColumn& column = columns_[i];
+    buffer.clear();
+    AppendUint32(buffer, i);
+    AppendUint32(buffer, static_cast<unsigned int>(column.value_count()));
+    AppendUint32(buffer, static_cast<unsigned int>(column.arena_.size()));
+    buffer.append(column.validity_.begin(), column.validity_.end());
+    buffer.resize(buffer.size() + GetBitmapSize(rows_) - column.validity_.size());
+    for (size_t j = 0; j < column.row_offsets_.size(); ++j)
+      AppendUint32(buffer, column.row_offsets_[j]);
+    for (size_t j = 0; j < column.value_offsets_.size(); ++j)
+      AppendUint32(buffer, column.value_offsets_[j]);
+    buffer.append(column.arena_);
+    file.write(buffer.data(), buffer.size());
+  }
+
+  return file.good();
+}
+
+bool ElementTable::Import(const std::string& path) {
+  clear();
+
+  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    return false;
+
+  char magic[sizeof(kElementTableMagic)];
+  unsigned int version = 0;
+  unsigned int rows = 0;
+  unsigned int column_count = 0;
+  if (!file.read(magic, sizeof(magic)) ||
+      !std::equal(magic, magic + sizeof(magic), kElementTableMagic) ||
+      !ReadUint32(file, version) || version != kElementTableVersion ||
+      !ReadUint32(file, rows) || !ReadUint32(file, column_count) ||
+      column_count > kElementIterateLast)
+    return false;
+
+  // Every column needs its bitmap and row offsets, so the row count alone
+  // tells whether the file can be large enough, before anything is allocated
+  const unsigned long long column_header_size = 3 * 4;
+  const unsigned long long min_column_size =
+      column_header_size + GetBitmapSize(rows) + (rows + 1ULL) * 4 + 4;
+  if (rows == kMaxOffset ||
+      GetRemainingSize(file) < column_count * min_column_size)
+    return false;
+
+  for (unsigned int i = 0; i < column_count; ++i) {
+    unsigned int category = 0;
+    unsigned int value_count = 0;
+    unsigned int arena_size = 0;
+    if (!ReadUint32(file, category) || category >= kElementIterateLast ||
+        !ReadUint32(file, value_count) || value_count == kMaxOffset ||
+        !ReadUint32(file, arena_size) ||
+        GetRemainingSize(file) < min_column_size - column_header_size +
+                                 value_count * 4ULL + arena_size) {
+      clear();
+      return false;
+    }
+
+    ElementColumn& column = columns_[category];
+    std::string validity;
+    if (!ReadBytes(file, GetBitmapSize(rows), validity) ||
+        !ReadOffsets(file, rows + 1, value_count, column.row_offsets_) ||
+        !CheckValidity(validity, column.row_offsets_) ||
+        !ReadOffsets(file, value_count + 1, arena_size, column.value_offsets_) ||
+        !ReadBytes(file, arena_size, column.arena_)) {
+      clear();
+      return false;
+    }
+    column.validity_.assign(validity.begin(),
+                            validity.begin() + (rows + 7) / 8);
+  }
+
+  // Columns that are missing from the file have no values
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+    ElementColumn& column = columns_[i];
+    if (column.row_offsets_.size() == 1) {
+      column.row_offsets_.assign(rows + 1, 0);
+      column.validity_.assign((rows + 7) / 8, 0);
+    }
+  }
+
+  rows_ = rows;
+  return true;
+}
+
+}  // namespace anitomy
\ No newline at end of file
@@ -0,0 +1,109 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_ELEMENT_TABLE_H
+#define ANITOMY_ELEMENT_TABLE_H
+
+#include <string>
+#include <vector>
+
+#include "element.h"
+#include "serialization.h"
+
+namespace anitomy {
+
+// All values of one category for every row of an ElementTable. Values are
+// UTF-8 and stored back to back in a single arena. A row may have any number
+// of values, so rows index into the value offsets rather than the arena.
+class ElementColumn {
+public:
+  typedef unsigned int offset_t;
+
+  ElementColumn();
+
+  // Values of every row, in order; this is the fast path for column scans
+  size_t value_count() const;
+  ElementValueView value(size_t index) const;
+
+  // Values of a single row are [row_begin(row), row_end(row))
+  size_t row_begin(size_t row) const;
+  size_t row_end(size_t row) const;
+  bool is_valid(size_t row) const;
+
+  size_t memory_usage() const;
+
+private:
+  friend class ElementTable;
+
+  // Offsets are 32-bit, so a column holds less than 4 GiB of values. A value
+  // that would not fit is refused, and DiscardValues() then drops the values
+  // that were appended since the last row.
+  void AppendRow();
+  bool AppendValue(const std::string& value);
+  void DiscardValues();
+
+  std::string arena_;
+  std::vector<offset_t> value_offsets_;  // value_count() + 1 entries
+  std::vector<offset_t> row_offsets_;    // rows + 1 entries
+  std::vector<unsigned char> validity_;  // One bit per row
+};
+
+// A column-oriented store for the results of many parses. Compared to keeping
+// an Elements object per file, there are no per-value allocations, and absent
+// categories cost a single bit.
+class ElementTable {
+public:
+  ElementTable();
+
+  // Returns false, and leaves the table as it was, if a column is full
+  bool Append(const Elements& elements);
+  void clear();
+
+  // Capacity
+  bool empty() const;
+  size_t rows() const;
+
+  // Value access
+  const ElementColumn& column(ElementCategory category) const;
+  ElementValueView get(size_t row, ElementCategory category) const;
+  size_t count(size_t row, ElementCategory category) const;
+  Elements row(size_t row) const;
+
+  size_t memory_usage() const;
+
+  // File format (all integers are little-endian uint32):
+  //
+  //   "ANTB", version, row count, column count
+  //   for each column:
+  //     category, value count, arena size
+  //     validity bitmap, padded to a multiple of 4 bytes
+  //     row offsets, value offsets, arena
+  //
+  // Import checks every size and offset against the file before it is used,
+  // and leaves the table empty if the file is truncated or inconsistent.
+  bool Export(const std::string& path) const;
+  bool Import(const std::string& path);
+
+private:
+  ElementColumn columns_[kElementIterateLast];
+  size_t rows_;
+};
+
+}  // namespace anitomy
+
+#endif  // ANITOMY_ELEMENT_TABLE_H
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include <algorithm>
 
 #include "keyword.h"
+#include "keyword_table.h"
 #include "token.h"
 
 namespace anitomy {
@@ -35,109 +36,52 @@ Keyword::Keyword(ElementCategory category, const KeywordOptions& options)
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#define Add_ { const char_t* k[] = 
-#define With(a, b) ; std::vector<string_t> v(k, k + _countof(k)); Add(a, b, v); }
-
-KeywordManager::KeywordManager() {
-  const KeywordOptions options_default;
-  const KeywordOptions options_invalid(true, true, false);
-  const KeywordOptions options_unidentifiable(false, true, true);
-  const KeywordOptions options_unidentifiable_invalid(false, true, false);
-  const KeywordOptions options_unidentifiable_unsearchable(false, false, true);
-
-  Add_{
-	  L"SAISON", L"SEASON"} With (kElementAnimeSeasonPrefix, options_unidentifiable);
-
-  Add_{
-      L"GEKIJOUBAN", L"MOVIE",
-      L"OAD", L"OAV", L"ONA", L"OVA",
-      L"SPECIAL", L"SPECIALS",
-      L"TV"} With (kElementAnimeType, options_unidentifiable);
-  Add_{
-      L"SP"} With (kElementAnimeType, options_unidentifiable_unsearchable);  // e.g. "Yumeiro Patissiere SP Professional"
-  Add_{
-      L"ED", L"ENDING", L"NCED",
-      L"NCOP", L"OP", L"OPENING",
-      L"PREVIEW", L"PV"} With (kElementAnimeType, options_unidentifiable_invalid);
-
-  Add_{
-      // Audio channels
-      L"2.0CH", L"2CH", L"5.1", L"5.1CH", L"DTS", L"DTS-ES", L"DTS5.1",
-      L"TRUEHD5.1",
-      // Audio codec
-      L"AAC", L"AACX2", L"AACX3", L"AACX4", L"AC3", L"FLAC", L"FLACX2",
-      L"FLACX3", L"FLACX4", L"LOSSLESS", L"MP3", L"OGG", L"VORBIS",
-      // Audio language
-      L"DUALAUDIO", L"DUAL AUDIO"} With (kElementAudioTerm, options_default);
-
-  Add_{
-      L"IPAD3", L"IPHONE5", L"IPOD", L"PS3", L"XBOX", L"XBOX360"} With (kElementDeviceCompatibility, options_default);
-  Add_{
-      L"ANDROID"} With (kElementDeviceCompatibility, options_unidentifiable);
-
-  Add_{
-      L"EP", L"EP.", L"EPS", L"EPS.", L"EPISODE", L"EPISODE.", L"EPISODES",
-      L"VOL", L"VOL.", L"VOLUME",
-      L"CAPITULO", L"EPISODIO", L"FOLGE"} With (kElementEpisodePrefix, options_default);
-  Add_{
-      L"E", L"\x7B2C"} With (kElementEpisodePrefix, options_invalid);  // single-letter episode keywords are not valid tokens
-
-  Add_{
-      L"3GP", L"AVI", L"DIVX", L"FLV", L"M2TS", L"MKV", L"MOV", L"MP4", L"MPG",
-      L"OGM", L"RM", L"RMVB", L"WEBM", L"WMV"} With (kElementFileExtension, options_default);
-  Add_{
-      L"AAC", L"AIFF", L"FLAC", L"M4A", L"MP3", L"MKA", L"OGG", L"WAV", L"WMA",
-      L"7Z", L"RAR", L"ZIP",
-      L"ASS", L"SRT"} With (kElementFileExtension, options_invalid);
-
-  Add_{
-      L"ENG", L"ENGLISH", L"ESPANOL", L"JAP", L"PT-BR", L"SPANISH", L"VOSTFR"} With (kElementLanguage, options_default);
-  Add_{
-      L"ESP", L"ITA"} With (kElementLanguage, options_unidentifiable);  // e.g. "Tokyo ESP", "Bokura ga Ita"
-
-  Add_{
-      L"REMASTER", L"REMASTERED", L"UNCENSORED", L"UNCUT",
-      L"TS", L"VFR", L"WIDESCREEN", L"WS"} With (kElementOther, options_default);
-
-  Add_{
-      L"THORA"} With (kElementReleaseGroup, options_default);
-
-  Add_{
-      L"BATCH", L"COMPLETE", L"PATCH", L"REMUX"} With (kElementReleaseInformation, options_default);
-  Add_{
-      L"END", L"FINAL"} With (kElementReleaseInformation, options_unidentifiable);  // e.g. "The End of Evangelion", "Final Approach"
-
-  Add_{
-      L"V0", L"V1", L"V2", L"V3", L"V4"} With (kElementReleaseVersion, options_default);
-
-  Add_{
-      L"BD", L"BDRIP", L"BLURAY", L"BLU-RAY",
-      L"DVD", L"DVD5", L"DVD9", L"DVD-R2J", L"DVDRIP", L"DVD-RIP",
-      L"R2DVD", L"R2J", L"R2JDVD", L"R2JDVDRIP",
-      L"HDTV", L"HDTVRIP", L"TVRIP", L"TV-RIP",
-      L"WEBCAST", L"WEBRIP"} With (kElementSource, options_default);
-
-  Add_{
-      L"ASS", L"BIG5", L"DUB", L"DUBBED", L"HARDSUB", L"RAW", L"SOFTSUB",
-      L"SOFTSUBS", L"SUB", L"SUBBED", L"SUBTITLED"} With (kElementSubtitles, options_default);
-
-  Add_{
-      // Frame rate
-      L"23.976FPS", L"24FPS", L"29.97FPS", L"30FPS", L"60FPS", L"120FPS",
-      // Video codec
-      L"8BIT", L"8-BIT", L"10BIT", L"10BITS", L"10-BIT", L"10-BITS", L"HI10P",
-      L"H264", L"H.264", L"X264", L"X.264",
-      L"AVC", L"DIVX", L"DIVX5", L"DIVX6", L"XVID",
-      // Video format
-      L"AVI", L"RMVB", L"WMV", L"WMV3", L"WMV9",
-      // Video quality
-      L"HQ", L"LQ",
-      // Video resolution
-      L"HD", L"SD"} With (kElementVideoTerm, options_default);
+// Returns the keyword in a sorted table, or NULL
+static const BuiltinKeyword* FindBuiltinKeyword(const BuiltinKeyword* begin,
+                                                const BuiltinKeyword* end,
+                                                const string_t& str) {
+  while (begin < end) {
+    const BuiltinKeyword* middle = begin + (end - begin) / 2;
+    const int result = str.compare(middle->keyword);
+    if (result == 0)
+      return middle;
+    if (result < 0) {
+      end = middle;
+    } else {
+      begin = middle + 1;
+    }
+  }
+  return NULL;
 }
 
-#undef With
-#undef Add_
+// Built-in keywords are found in their tables, and the ones that were added
+// at runtime in a map, which stays empty unless Add is called
+bool KeywordManager::FindKeyword(ElementCategory category,
+                                 const string_t& str,
+                                 Keyword& keyword) const {
+  const BuiltinKeyword* builtin = category == kElementFileExtension ?
+      FindBuiltinKeyword(builtin_file_extensions,
+                         builtin_file_extensions +
+                             _countof(builtin_file_extensions),
+                         str) :
+      FindBuiltinKeyword(builtin_keywords,
+                         builtin_keywords + _countof(builtin_keywords), str);
+  if (builtin) {
+    keyword.category = builtin->category;
+    keyword.options = KeywordOptions(
+        !(builtin->flags & kKeywordUnidentifiable),
+        !(builtin->flags & kKeywordUnsearchable),
+        !(builtin->flags & kKeywordInvalid));
+    return true;
+  }
+
+  const keyword_container_t& keys = GetKeywordContainer(category);
+  const keyword_container_t::const_iterator it = keys.find(str);
+  if (it == keys.end())
+    return false;
+  keyword = it->second;
+  return true;
+}
 
 void KeywordManager::Add(ElementCategory category,
                          const KeywordOptions& options,
@@ -146,36 +90,57 @@ void KeywordManager::Add(ElementCategory category,
   for (std::vector<string_t>::const_iterator keyword = keywords.begin(); keyword != keywords.end(); ++keyword) {
     if (keyword->empty())
       continue;
-    if (keys.find(*keyword) != keys.end())
+    Keyword existing(category, options);
+    if (FindKeyword(category, *keyword, existing))
       continue;
     keys.insert(std::make_pair(*keyword, Keyword(category, options)));
   }
 }
 
 bool KeywordManager::Find(ElementCategory category, const string_t& str) const {
-  const KeywordManager::keyword_container_t& keys = GetKeywordContainer(category);
-  const KeywordManager::keyword_container_t::const_iterator it = keys.find(str);
-  if (it != keys.end() && it->second.category == category)
-    return true;
-
-  return false;
+  Keyword keyword(kElementUnknown, KeywordOptions());
+  return FindKeyword(category, str, keyword) && keyword.category == category;
 }
 
 bool KeywordManager::Find(const string_t& str, ElementCategory& category,
                           KeywordOptions& options) const {
-  const KeywordManager::keyword_container_t& keys = GetKeywordContainer(category);
-  const KeywordManager::keyword_container_t::const_iterator it = keys.find(str);
-  if (it != keys.end()) {
-    if (category == kElementUnknown) {
-      category = it->second.category;
-    } else if (it->second.category != category) {
-      return false;
-    }
-    options = it->second.options;
-    return true;
+  Keyword keyword(kElementUnknown, KeywordOptions());
+  if (!FindKeyword(category, str, keyword))
+    return false;
+  if (category == kElementUnknown) {
+    category = keyword.category;
+  } else if (keyword.category != category) {
+    return false;
   }
+  options = keyword.options;
+  return true;
+}
 
-  return false;
+// In the same order as if every keyword was in the map
+void KeywordManager::GetKeywords(ElementCategory category,
+                                 std::vector<string_t>& keywords) const {
+  const BuiltinKeyword* builtin = builtin_keywords;
+  const BuiltinKeyword* builtin_end =
+      builtin_keywords + _countof(builtin_keywords);
+  if (category == kElementFileExtension) {
+    builtin = builtin_file_extensions;
+    builtin_end = builtin_file_extensions + _countof(builtin_file_extensions);
+  }
+  const keyword_container_t& keys = GetKeywordContainer(category);
+  keyword_container_t::const_iterator it = keys.begin();
+
+  while (builtin != builtin_end || it != keys.end()) {
+    if (it == keys.end() ||
+        (builtin != builtin_end && it->first.compare(builtin->keyword) > 0)) {
+      if (builtin->category == category)
+        keywords.push_back(builtin->keyword);
+      ++builtin;
+    } else {
+      if (it->second.category == category)
+        keywords.push_back(it->first);
+      ++it;
+    }
+  }
 }
 
 string_t KeywordManager::Normalize(const string_t& str) const {
@@ -195,23 +160,33 @@ void KeywordManager::Peek(const string_t& filename,
                           const TokenRange& range,
                           Elements& elements,
                           std::vector<TokenRange>& preidentified_tokens) const {
-  typedef std::pair<ElementCategory, std::vector<string_t>> entry_t;
-  static /*const*/ std::vector<entry_t> entries;
-  { ElementCategory c = kElementAudioTerm;       const char_t* k[] = {L"Dual Audio"}; entry_t e; e.first = c; e.second.assign(k, k + _countof(k)); entries.push_back(e); }
-  { ElementCategory c = kElementVideoTerm;       const char_t* k[] = {L"H264", L"H.264", L"h264", L"h.264"}; entry_t e; e.first = c; e.second.assign(k, k + _countof(k)); entries.push_back(e); }
-  { ElementCategory c = kElementVideoResolution; const char_t* k[] = {L"480p", L"720p", L"1080p"}; entry_t e; e.first = c; e.second.assign(k, k + _countof(k)); entries.push_back(e); }
-  { ElementCategory c = kElementSource;          const char_t* k[] = {L"Blu-Ray"}; entry_t e; e.first = c; e.second.assign(k, k + _countof(k)); entries.push_back(e); }
+  struct entry_t {
+    ElementCategory category;
+    const char_t* const* keywords;
+    size_t count;
+  };
+  static const char_t* const audio_terms[] = {L"Dual Audio"};
+  static const char_t* const video_terms[] = {L"H264", L"H.264", L"h264", L"h.264"};
+  static const char_t* const video_resolutions[] = {L"480p", L"720p", L"1080p"};
+  static const char_t* const sources[] = {L"Blu-Ray"};
+  static const entry_t entries[] = {
+    {kElementAudioTerm, audio_terms, _countof(audio_terms)},
+    {kElementVideoTerm, video_terms, _countof(video_terms)},
+    {kElementVideoResolution, video_resolutions, _countof(video_resolutions)},
+    {kElementSource, sources, _countof(sources)},
+  };
 
   string_t::const_iterator it_begin = filename.begin() + range.offset;
   string_t::const_iterator it_end = it_begin + range.size;
 
-  for(std::vector<entry_t>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry) {
-    for(std::vector<string_t>::const_iterator keyword = entry->second.begin(); keyword != entry->second.end(); ++keyword) {
-      string_t::const_iterator it = std::search(it_begin, it_end, keyword->begin(), keyword->end());
+  for (const entry_t* entry = entries; entry != entries + _countof(entries); ++entry) {
+    for (const char_t* const* keyword = entry->keywords; keyword != entry->keywords + entry->count; ++keyword) {
+      const size_t keyword_size = string_t::traits_type::length(*keyword);
+      string_t::const_iterator it = std::search(it_begin, it_end, *keyword, *keyword + keyword_size);
       if (it != it_end) {
         size_t offset = it - filename.begin();
-        elements.insert(entry->first, *keyword);
-        preidentified_tokens.push_back(TokenRange(offset, keyword->size()));
+        elements.insert(entry->category, TokenRange(offset, keyword_size));
+        preidentified_tokens.push_back(TokenRange(offset, keyword_size));
       }
     }
   }
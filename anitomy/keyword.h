@@ -48,15 +48,18 @@ public:
   KeywordOptions options;
 };
 
+// A keyword set: the built-in keywords, and the ones added with Add. Since
+// keywords are compared after Normalize, added ones must be in upper case.
+// Nothing else changes a KeywordManager, so it can be shared between threads
+// once it is built (see Anitomy::set_keywords).
 class KeywordManager {
 public:
-  KeywordManager();
-
   void Add(ElementCategory category, const KeywordOptions& options,
            const std::vector<string_t>& keywords);
 
   bool Find(ElementCategory category, const string_t& str) const;
   bool Find(const string_t& str, ElementCategory& category, KeywordOptions& options) const;
+  void GetKeywords(ElementCategory category, std::vector<string_t>& keywords) const;
 
   void Peek(const string_t& filename, const TokenRange& range, Elements& elements,
             std::vector<TokenRange>& preidentified_tokens) const;
@@ -66,12 +69,16 @@ public:
 private:
   typedef std::map<string_t, Keyword> keyword_container_t;
 
+  bool FindKeyword(ElementCategory category, const string_t& str,
+                   Keyword& keyword) const;
   keyword_container_t& GetKeywordContainer(ElementCategory category) const;
 
+  // Keywords added at runtime, see keyword_table.h for the built-in ones
   keyword_container_t file_extensions_;
   keyword_container_t keys_;
 };
 
+// The keyword set of every Anitomy object unless it is given another one
 extern KeywordManager keyword_manager;
 
 }  // namespace anitomy
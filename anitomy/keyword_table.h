@@ -0,0 +1,240 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_KEYWORD_TABLE_H
+#define ANITOMY_KEYWORD_TABLE_H
+
+#include "element.h"
+#include "string.h"
+
+// Built-in keywords for keyword.cpp. Each table is sorted in the order of
+// string_t::compare, so that it can be searched in place. Being aggregates of
+// constants, the tables are initialized at compile time: no constructor runs
+// for them before main, and they need no memory on the heap.
+//
+// File extensions are kept apart, because some of them are also keywords of
+// other categories, e.g. "AAC" and "ASS".
+
+namespace anitomy {
+
+enum BuiltinKeywordFlags {
+  kKeywordDefault = 0,
+  kKeywordUnidentifiable = 1 << 0,
+  kKeywordUnsearchable = 1 << 1,
+  kKeywordInvalid = 1 << 2
+};
+
+struct BuiltinKeyword {
+  const char_t* keyword;
+  ElementCategory category;
+  int flags;
+};
+
+static const BuiltinKeyword builtin_keywords[] = {
+  {L"10-BIT", kElementVideoTerm, kKeywordDefault},
+  {L"10-BITS", kElementVideoTerm, kKeywordDefault},
+  {L"10BIT", kElementVideoTerm, kKeywordDefault},
+  {L"10BITS", kElementVideoTerm, kKeywordDefault},
+  {L"120FPS", kElementVideoTerm, kKeywordDefault},
+  {L"2.0CH", kElementAudioTerm, kKeywordDefault},
+  {L"23.976FPS", kElementVideoTerm, kKeywordDefault},
+  {L"24FPS", kElementVideoTerm, kKeywordDefault},
+  {L"29.97FPS", kElementVideoTerm, kKeywordDefault},
+  {L"2CH", kElementAudioTerm, kKeywordDefault},
+  {L"30FPS", kElementVideoTerm, kKeywordDefault},
+  {L"5.1", kElementAudioTerm, kKeywordDefault},
+  {L"5.1CH", kElementAudioTerm, kKeywordDefault},
+  {L"60FPS", kElementVideoTerm, kKeywordDefault},
+  {L"8-BIT", kElementVideoTerm, kKeywordDefault},
+  {L"8BIT", kElementVideoTerm, kKeywordDefault},
+  {L"AAC", kElementAudioTerm, kKeywordDefault},
+  {L"AACX2", kElementAudioTerm, kKeywordDefault},
+  {L"AACX3", kElementAudioTerm, kKeywordDefault},
+  {L"AACX4", kElementAudioTerm, kKeywordDefault},
+  {L"AC3", kElementAudioTerm, kKeywordDefault},
+  {L"ANDROID", kElementDeviceCompatibility, kKeywordUnidentifiable},
+  {L"ASS", kElementSubtitles, kKeywordDefault},
+  {L"AVC", kElementVideoTerm, kKeywordDefault},
+  {L"AVI", kElementVideoTerm, kKeywordDefault},
+  {L"BATCH", kElementReleaseInformation, kKeywordDefault},
+  {L"BD", kElementSource, kKeywordDefault},
+  {L"BDRIP", kElementSource, kKeywordDefault},
+  {L"BIG5", kElementSubtitles, kKeywordDefault},
+  {L"BLU-RAY", kElementSource, kKeywordDefault},
+  {L"BLURAY", kElementSource, kKeywordDefault},
+  {L"CAPITULO", kElementEpisodePrefix, kKeywordDefault},
+  {L"COMPLETE", kElementReleaseInformation, kKeywordDefault},
+  {L"DIVX", kElementVideoTerm, kKeywordDefault},
+  {L"DIVX5", kElementVideoTerm, kKeywordDefault},
+  {L"DIVX6", kElementVideoTerm, kKeywordDefault},
+  {L"DTS", kElementAudioTerm, kKeywordDefault},
+  {L"DTS-ES", kElementAudioTerm, kKeywordDefault},
+  {L"DTS5.1", kElementAudioTerm, kKeywordDefault},
+  {L"DUAL AUDIO", kElementAudioTerm, kKeywordDefault},
+  {L"DUALAUDIO", kElementAudioTerm, kKeywordDefault},
+  {L"DUB", kElementSubtitles, kKeywordDefault},
+  {L"DUBBED", kElementSubtitles, kKeywordDefault},
+  {L"DVD", kElementSource, kKeywordDefault},
+  {L"DVD-R2J", kElementSource, kKeywordDefault},
+  {L"DVD-RIP", kElementSource, kKeywordDefault},
+  {L"DVD5", kElementSource, kKeywordDefault},
+  {L"DVD9", kElementSource, kKeywordDefault},
+  {L"DVDRIP", kElementSource, kKeywordDefault},
+  {L"E", kElementEpisodePrefix, kKeywordInvalid},  // A single letter is not a valid token
+  {L"ED", kElementAnimeType, kKeywordUnidentifiable | kKeywordInvalid},
+  {L"END", kElementReleaseInformation, kKeywordUnidentifiable},  // e.g. "The End of Evangelion"
+  {L"ENDING", kElementAnimeType, kKeywordUnidentifiable | kKeywordInvalid},
+  {L"ENG", kElementLanguage, kKeywordDefault},
+  {L"ENGLISH", kElementLanguage, kKeywordDefault},
+  {L"EP", kElementEpisodePrefix, kKeywordDefault},
+  {L"EP.", kElementEpisodePrefix, kKeywordDefault},
+  {L"EPISODE", kElementEpisodePrefix, kKeywordDefault},
+  {L"EPISODE.", kElementEpisodePrefix, kKeywordDefault},
+  {L"EPISODES", kElementEpisodePrefix, kKeywordDefault},
+  {L"EPISODIO", kElementEpisodePrefix, kKeywordDefault},
+  {L"EPS", kElementEpisodePrefix, kKeywordDefault},
+  {L"EPS.", kElementEpisodePrefix, kKeywordDefault},
+  {L"ESP", kElementLanguage, kKeywordUnidentifiable},  // e.g. "Tokyo ESP"
+  {L"ESPANOL", kElementLanguage, kKeywordDefault},
+  {L"FINAL", kElementReleaseInformation, kKeywordUnidentifiable},  // e.g. "Final Approach"
+  {L"FLAC", kElementAudioTerm, kKeywordDefault},
+  {L"FLACX2", kElementAudioTerm, kKeywordDefault},
+  {L"FLACX3", kElementAudioTerm, kKeywordDefault},
+  {L"FLACX4", kElementAudioTerm, kKeywordDefault},
+  {L"FOLGE", kElementEpisodePrefix, kKeywordDefault},
+  {L"GEKIJOUBAN", kElementAnimeType, kKeywordUnidentifiable},
+  {L"H.264", kElementVideoTerm, kKeywordDefault},
+  {L"H264", kElementVideoTerm, kKeywordDefault},
+  {L"HARDSUB", kElementSubtitles, kKeywordDefault},
+  {L"HD", kElementVideoTerm, kKeywordDefault},
+  {L"HDTV", kElementSource, kKeywordDefault},
+  {L"HDTVRIP", kElementSource, kKeywordDefault},
+  {L"HI10P", kElementVideoTerm, kKeywordDefault},
+  {L"HQ", kElementVideoTerm, kKeywordDefault},
+  {L"IPAD3", kElementDeviceCompatibility, kKeywordDefault},
+  {L"IPHONE5", kElementDeviceCompatibility, kKeywordDefault},
+  {L"IPOD", kElementDeviceCompatibility, kKeywordDefault},
+  {L"ITA", kElementLanguage, kKeywordUnidentifiable},  // e.g. "Bokura ga Ita"
+  {L"JAP", kElementLanguage, kKeywordDefault},
+  {L"LOSSLESS", kElementAudioTerm, kKeywordDefault},
+  {L"LQ", kElementVideoTerm, kKeywordDefault},
+  {L"MOVIE", kElementAnimeType, kKeywordUnidentifiable},
+  {L"MP3", kElementAudioTerm, kKeywordDefault},
+  {L"NCED", kElementAnimeType, kKeywordUnidentifiable | kKeywordInvalid},
+  {L"NCOP", kElementAnimeType, kKeywordUnidentifiable | kKeywordInvalid},
+  {L"OAD", kElementAnimeType, kKeywordUnidentifiable},
+  {L"OAV", kElementAnimeType, kKeywordUnidentifiable},
+  {L"OGG", kElementAudioTerm, kKeywordDefault},
+  {L"ONA", kElementAnimeType, kKeywordUnidentifiable},
+  {L"OP", kElementAnimeType, kKeywordUnidentifiable | kKeywordInvalid},
+  {L"OPENING", kElementAnimeType, kKeywordUnidentifiable | kKeywordInvalid},
+  {L"OVA", kElementAnimeType, kKeywordUnidentifiable},
+  {L"PATCH", kElementReleaseInformation, kKeywordDefault},
+  {L"PREVIEW", kElementAnimeType, kKeywordUnidentifiable | kKeywordInvalid},
+  {L"PS3", kElementDeviceCompatibility, kKeywordDefault},
+  {L"PT-BR", kElementLanguage, kKeywordDefault},
+  {L"PV", kElementAnimeType, kKeywordUnidentifiable | kKeywordInvalid},
+  {L"R2DVD", kElementSource, kKeywordDefault},
+  {L"R2J", kElementSource, kKeywordDefault},
+  {L"R2JDVD", kElementSource, kKeywordDefault},
+  {L"R2JDVDRIP", kElementSource, kKeywordDefault},
+  {L"RAW", kElementSubtitles, kKeywordDefault},
+  {L"REMASTER", kElementOther, kKeywordDefault},
+  {L"REMASTERED", kElementOther, kKeywordDefault},
+  {L"REMUX", kElementReleaseInformation, kKeywordDefault},
+  {L"RMVB", kElementVideoTerm, kKeywordDefault},
+  {L"SAISON", kElementAnimeSeasonPrefix, kKeywordUnidentifiable},
+  {L"SD", kElementVideoTerm, kKeywordDefault},
+  {L"SEASON", kElementAnimeSeasonPrefix, kKeywordUnidentifiable},
+  {L"SOFTSUB", kElementSubtitles, kKeywordDefault},
+  {L"SOFTSUBS", kElementSubtitles, kKeywordDefault},
+  {L"SP", kElementAnimeType, kKeywordUnidentifiable | kKeywordUnsearchable},  // e.g. "Yumeiro Patissiere SP Professional"
+  {L"SPANISH", kElementLanguage, kKeywordDefault},
+  {L"SPECIAL", kElementAnimeType, kKeywordUnidentifiable},
+  {L"SPECIALS", kElementAnimeType, kKeywordUnidentifiable},
+  {L"SUB", kElementSubtitles, kKeywordDefault},
+  {L"SUBBED", kElementSubtitles, kKeywordDefault},
+  {L"SUBTITLED", kElementSubtitles, kKeywordDefault},
+  {L"THORA", kElementReleaseGroup, kKeywordDefault},
+  {L"TRUEHD5.1", kElementAudioTerm, kKeywordDefault},
+  {L"TS", kElementOther, kKeywordDefault},
+  {L"TV", kElementAnimeType, kKeywordUnidentifiable},
+  {L"TV-RIP", kElementSource, kKeywordDefault},
+  {L"TVRIP", kElementSource, kKeywordDefault},
+  {L"UNCENSORED", kElementOther, kKeywordDefault},
+  {L"UNCUT", kElementOther, kKeywordDefault},
+  {L"V0", kElementReleaseVersion, kKeywordDefault},
+  {L"V1", kElementReleaseVersion, kKeywordDefault},
+  {L"V2", kElementReleaseVersion, kKeywordDefault},
+  {L"V3", kElementReleaseVersion, kKeywordDefault},
+  {L"V4", kElementReleaseVersion, kKeywordDefault},
+  {L"VFR", kElementOther, kKeywordDefault},
+  {L"VOL", kElementEpisodePrefix, kKeywordDefault},
+  {L"VOL.", kElementEpisodePrefix, kKeywordDefault},
+  {L"VOLUME", kElementEpisodePrefix, kKeywordDefault},
+  {L"VORBIS", kElementAudioTerm, kKeywordDefault},
+  {L"VOSTFR", kElementLanguage, kKeywordDefault},
+  {L"WEBCAST", kElementSource, kKeywordDefault},
+  {L"WEBRIP", kElementSource, kKeywordDefault},
+  {L"WIDESCREEN", kElementOther, kKeywordDefault},
+  {L"WMV", kElementVideoTerm, kKeywordDefault},
+  {L"WMV3", kElementVideoTerm, kKeywordDefault},
+  {L"WMV9", kElementVideoTerm, kKeywordDefault},
+  {L"WS", kElementOther, kKeywordDefault},
+  {L"X.264", kElementVideoTerm, kKeywordDefault},
+  {L"X264", kElementVideoTerm, kKeywordDefault},
+  {L"XBOX", kElementDeviceCompatibility, kKeywordDefault},
+  {L"XBOX360", kElementDeviceCompatibility, kKeywordDefault},
+  {L"XVID", kElementVideoTerm, kKeywordDefault},
+  {L"\x7B2C", kElementEpisodePrefix, kKeywordInvalid},  // "Dai", as in "Dai 01 Wa"
+};
+
+static const BuiltinKeyword builtin_file_extensions[] = {
+  {L"3GP", kElementFileExtension, kKeywordDefault},
+  {L"7Z", kElementFileExtension, kKeywordInvalid},
+  {L"AAC", kElementFileExtension, kKeywordInvalid},
+  {L"AIFF", kElementFileExtension, kKeywordInvalid},
+  {L"ASS", kElementFileExtension, kKeywordInvalid},
+  {L"AVI", kElementFileExtension, kKeywordDefault},
+  {L"DIVX", kElementFileExtension, kKeywordDefault},
+  {L"FLAC", kElementFileExtension, kKeywordInvalid},
+  {L"FLV", kElementFileExtension, kKeywordDefault},
+  {L"M2TS", kElementFileExtension, kKeywordDefault},
+  {L"M4A", kElementFileExtension, kKeywordInvalid},
+  {L"MKA", kElementFileExtension, kKeywordInvalid},
+  {L"MKV", kElementFileExtension, kKeywordDefault},
+  {L"MOV", kElementFileExtension, kKeywordDefault},
+  {L"MP3", kElementFileExtension, kKeywordInvalid},
+  {L"MP4", kElementFileExtension, kKeywordDefault},
+  {L"MPG", kElementFileExtension, kKeywordDefault},
+  {L"OGG", kElementFileExtension, kKeywordInvalid},
+  {L"OGM", kElementFileExtension, kKeywordDefault},
+  {L"RAR", kElementFileExtension, kKeywordInvalid},
+  {L"RM", kElementFileExtension, kKeywordDefault},
+  {L"RMVB", kElementFileExtension, kKeywordDefault},
+  {L"SRT", kElementFileExtension, kKeywordInvalid},
+  {L"WAV", kElementFileExtension, kKeywordInvalid},
+  {L"WEBM", kElementFileExtension, kKeywordDefault},
+  {L"WMA", kElementFileExtension, kKeywordInvalid},
+  {L"WMV", kElementFileExtension, kKeywordDefault},
+  {L"ZIP", kElementFileExtension, kKeywordInvalid},
+};
+
+}  // namespace anitomy
+
+#endif  // ANITOMY_KEYWORD_TABLE_H
\ No newline at end of file
@@ -21,6 +21,7 @@
 
 #include <vector>
 
+#include "element.h"
 #include "string.h"
 
 namespace anitomy {
@@ -34,6 +35,18 @@ struct Options {
   bool parse_file_extension;
   bool parse_release_group;
 
+  // Maps fullwidth forms to ASCII before tokenizing (see NormalizeWidth), so
+  // that e.g. fullwidth digits are numbers
+  bool normalize_width;
+
+  // Categories that the caller needs. Stages that cannot affect any of them
+  // are skipped, and elements of other categories are not kept.
+  element_category_mask_t requested_categories;
+
+  // Work budget of a single parse, see WorkBudget; zero means no limit
+  size_t max_work;
+  unsigned long long max_nanoseconds;
+
   Options()
   {
   allowed_delimiters = L" _.&+,|";
@@ -42,6 +55,13 @@ struct Options {
   parse_episode_title = true;
   parse_file_extension = true;
   parse_release_group = true;
+
+  normalize_width = true;
+
+  requested_categories = kElementCategoryMaskAll;
+
+  max_work = 0;
+  max_nanoseconds = 0;
   }
 };
 
@@ -20,6 +20,7 @@
 
 #include "keyword.h"
 #include "parser.h"
+#include "stats.h"
 #include "string.h"
 
 namespace anitomy {
@@ -29,42 +30,67 @@ namespace anitomy {
 	const int Parser::kEpisodeNumberMax = Parser::kAnimeYearMin - 1;
 
 Parser::Parser(Elements& elements, const Options& options,
-               token_container_t& tokens)
+               const KeywordManager& keywords, token_container_t& tokens,
+               ParseStats* stats, WorkBudget* budget)
     : elements_(elements),
       options_(options),
-      tokens_(tokens) {
+      keywords_(keywords),
+      tokens_(tokens),
+      stats_(stats),
+      budget_(budget),
+      element_token_offset_(string_t::npos),
+      element_token_end_(0) {
 }
 
 bool Parser::Parse() {
-  SearchForKeywords();
-
-  SearchForIsolatedNumbers();
-
-  if (options_.parse_episode_number &&
-      elements_.empty(kElementEpisodeNumber))
-    SearchForEpisodeNumber();
+  return Parse(RuntimeProfile(options_));
+}
 
-  SearchForAnimeTitle();
+ParseStage Parser::GetLastRequiredStage() const {
+  if (IsCategoryRequested(kElementEpisodeTitle))
+    return kParseStageSearchForEpisodeTitle;
+  if (IsCategoryRequested(kElementReleaseGroup))
+    return kParseStageSearchForReleaseGroup;
+  if (IsCategoryRequested(kElementAnimeTitle))
+    return kParseStageSearchForAnimeTitle;
+
+  // These can also be found while searching for keywords
+  if (IsCategoryRequested(kElementAnimeSeason) ||
+      IsCategoryRequested(kElementAnimeType) ||
+      IsCategoryRequested(kElementEpisodeNumber) ||
+      IsCategoryRequested(kElementReleaseVersion))
+    return kParseStageSearchForEpisodeNumber;
+  if (IsCategoryRequested(kElementAnimeYear) ||
+      IsCategoryRequested(kElementVideoResolution))
+    return kParseStageSearchForIsolatedNumbers;
+
+  return kParseStageSearchForKeywords;
+}
 
-  if (options_.parse_release_group &&
-      elements_.empty(kElementReleaseGroup))
-    SearchForReleaseGroup();
+bool Parser::IsCategoryRequested(ElementCategory category) const {
+  return (options_.requested_categories & ElementCategoryMask(category)) != 0;
+}
 
-  if (options_.parse_episode_title &&
-      !elements_.empty(kElementEpisodeNumber))
-    SearchForEpisodeTitle();
+bool Parser::Spend(size_t steps) {
+  return !budget_ || budget_->Spend(steps);
+}
 
-  return !elements_.empty(kElementAnimeTitle);
+bool Parser::IsBudgetExceeded() const {
+  return budget_ && budget_->exceeded();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Parser::SearchForKeywords() {
+void Parser::SearchForKeywords(bool parse_release_group) {
+  ANITOMY_TIME_STAGE(stats_, kParseStageSearchForKeywords);
+
   for (token_container_t::iterator it = tokens_.begin(); it != tokens_.end(); ++it) {
     Token& token = *it;
 
     if (token.category != kUnknown)
       continue;
+    if (!Spend(1))
+      return;
 
     string_t word = token.content;
     TrimString(word, L" -");
@@ -76,12 +102,12 @@ void Parser::SearchForKeywords() {
       continue;
 
     // Performs better than making a case-insensitive Find
-    string_t keyword = keyword_manager.Normalize(word);
+    string_t keyword = keywords_.Normalize(word);
     ElementCategory category = kElementUnknown;
     KeywordOptions options;
 
-    if (keyword_manager.Find(keyword, category, options)) {
-      if (!options_.parse_release_group && category == kElementReleaseGroup)
+    if (keywords_.Find(keyword, category, options)) {
+      if (!parse_release_group && category == kElementReleaseGroup)
         continue;
       if (!IsElementCategorySearchable(category) || !options.searchable)
         continue;
@@ -107,7 +133,7 @@ void Parser::SearchForKeywords() {
     }
 
     if (category != kElementUnknown) {
-      elements_.insert(category, word);
+      InsertElement(category, word, token);
       if (options.identifiable || token.enclosed)
         token.category = kIdentifier;
     }
@@ -121,7 +147,11 @@ bool Parser::not_numeric_string(size_t index) {
 };
 
 void Parser::SearchForEpisodeNumber() {
+  ANITOMY_TIME_STAGE(stats_, kParseStageSearchForEpisodeNumber);
+
   // List all unknown tokens that contain a number
+  if (!Spend(tokens_.size()))
+    return;
   std::vector<size_t> tokens;
   for (size_t i = 0; i < tokens_.size(); ++i) {
     Token& token = tokens_.at(i);
@@ -144,24 +174,30 @@ void Parser::SearchForEpisodeNumber() {
     return;
 
   // e.g. "01 (176)", "29 (04)"
-  if (SearchForEquivalentNumbers(tokens))
+  if (ANITOMY_COUNT_RULE(stats_, kParseRuleEquivalentNumbers,
+                         SearchForEquivalentNumbers(tokens)))
     return;
 
   // e.g. " - 08"
-  if (SearchForSeparatedNumbers(tokens))
+  if (ANITOMY_COUNT_RULE(stats_, kParseRuleSeparatedNumbers,
+                         SearchForSeparatedNumbers(tokens)))
     return;
 
   // e.g. "[12]", "(2006)"
-  if (SearchForIsolatedNumbers(tokens))
+  if (ANITOMY_COUNT_RULE(stats_, kParseRuleIsolatedNumbers,
+                         SearchForIsolatedNumbers(tokens)))
     return;
 
   // Consider using the last number as a last resort
-  SearchForLastNumber(tokens);
+  ANITOMY_COUNT_RULE(stats_, kParseRuleLastNumber,
+                     SearchForLastNumber(tokens));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Parser::SearchForAnimeTitle() {
+  ANITOMY_TIME_STAGE(stats_, kParseStageSearchForAnimeTitle);
+
   bool enclosed_title = false;
 
   // Find the first non-enclosed unknown token
@@ -216,6 +252,8 @@ void Parser::SearchForAnimeTitle() {
 }
 
 void Parser::SearchForReleaseGroup() {
+  ANITOMY_TIME_STAGE(stats_, kParseStageSearchForReleaseGroup);
+
   token_container_t::iterator token_begin = tokens_.begin();
   token_container_t::iterator token_end = tokens_.begin();
 
@@ -229,7 +267,7 @@ void Parser::SearchForReleaseGroup() {
     // Continue until a bracket or identifier is found
     token_end = FindToken(token_begin, tokens_.end(),
                           kFlagBracket | kFlagIdentifier);
-    if (token_end->category != kBracket)
+    if (token_end == tokens_.end() || token_end->category != kBracket)
       continue;
 
     // Ignore if it's not the first non-delimiter token in group
@@ -247,6 +285,8 @@ void Parser::SearchForReleaseGroup() {
 }
 
 void Parser::SearchForEpisodeTitle() {
+  ANITOMY_TIME_STAGE(stats_, kParseStageSearchForEpisodeTitle);
+
   // Find the first non-enclosed unknown token
   token_container_t::iterator token_begin = FindToken(tokens_.begin(), tokens_.end(),
                                kFlagNotEnclosed | kFlagUnknown);
@@ -264,7 +304,11 @@ void Parser::SearchForEpisodeTitle() {
 ////////////////////////////////////////////////////////////////////////////////
 
 void Parser::SearchForIsolatedNumbers() {
+  ANITOMY_TIME_STAGE(stats_, kParseStageSearchForIsolatedNumbers);
+
   for (token_container_t::iterator token = tokens_.begin(); token != tokens_.end(); ++token) {
+    if (!Spend(1))
+      return;
     if (token->category != kUnknown ||
         !IsNumericString(token->content) ||
         !IsTokenIsolated(token))
@@ -275,7 +319,7 @@ void Parser::SearchForIsolatedNumbers() {
     // Anime year
     if (number >= kAnimeYearMin && number <= kAnimeYearMax) {
       if (elements_.empty(kElementAnimeYear)) {
-        elements_.insert(kElementAnimeYear, token->content);
+        InsertElement(kElementAnimeYear, token->content, *token);
         token->category = kIdentifier;
         continue;
       }
@@ -287,7 +331,7 @@ void Parser::SearchForIsolatedNumbers() {
       // video resolution rather than the episode number. Some fansub groups
       // use these without the "p" suffix.
       if (elements_.empty(kElementVideoResolution)) {
-        elements_.insert(kElementVideoResolution, token->content);
+        InsertElement(kElementVideoResolution, token->content, *token);
         token->category = kIdentifier;
         continue;
       }
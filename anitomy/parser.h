@@ -19,8 +19,12 @@
 #ifndef ANITOMY_PARSER_H
 #define ANITOMY_PARSER_H
 
+#include "budget.h"
 #include "element.h"
+#include "keyword.h"
 #include "options.h"
+#include "profile.h"
+#include "stats.h"
 #include "string.h"
 #include "token.h"
 
@@ -28,15 +32,21 @@ namespace anitomy {
 
 class Parser {
 public:
-  Parser(Elements& elements, const Options& options, token_container_t& tokens);
+  Parser(Elements& elements, const Options& options,
+         const KeywordManager& keywords, token_container_t& tokens,
+         ParseStats* stats = NULL, WorkBudget* budget = NULL);
 
   Parser(const Parser&);// = delete;
   Parser& operator=(const Parser&);// = delete;
 
   bool Parse();
 
+  // See profile.h
+  template <class Profile>
+  bool Parse(const Profile& profile);
+
 private:
-  void SearchForKeywords();
+  void SearchForKeywords(bool parse_release_group);
 bool not_numeric_string(size_t index);
   void SearchForEpisodeNumber();
   void SearchForAnimeTitle();
@@ -79,21 +89,86 @@ bool not_numeric_string(size_t index);
   bool CheckAnimeSeasonKeyword(const token_iterator_t token);
   bool CheckEpisodeKeyword(const token_iterator_t token);
 
+  ParseStage GetLastRequiredStage() const;
+  bool IsCategoryRequested(ElementCategory category) const;
+
+  void InsertElement(ElementCategory category, const string_t& value,
+                     const Token& token);
   void BuildElement(ElementCategory category, bool keep_delimiters,
                     const token_iterator_t token_begin,
                     const token_iterator_t token_end) const;
 
   bool IsTokenIsolated(const token_iterator_t token) const;
 
+  bool Spend(size_t steps);
+  bool IsBudgetExceeded() const;
+
   static const int kAnimeYearMin;
   static const int kAnimeYearMax;
   static const int kEpisodeNumberMax;
 
   Elements& elements_;
   const Options& options_;
+  const KeywordManager& keywords_;
   token_container_t& tokens_;
+  ParseStats* stats_;
+  WorkBudget* budget_;
+
+  // The last value that InsertElement found in a token
+  size_t element_token_offset_;
+  size_t element_token_end_;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+
+template <class Profile>
+bool Parser::Parse(const Profile& profile) {
+  // A stage only depends on the ones before it, so there is no need to go
+  // further than the last stage that can find a requested element. Stopping
+  // early is still a failure if the budget ran out on the way.
+  const ParseStage last_stage = GetLastRequiredStage();
+
+  SearchForKeywords(profile.parse_release_group());
+  if (last_stage == kParseStageSearchForKeywords)
+    return !IsBudgetExceeded();
+
+  SearchForIsolatedNumbers();
+  if (last_stage == kParseStageSearchForIsolatedNumbers)
+    return !IsBudgetExceeded();
+
+  if (profile.parse_episode_number() &&
+      elements_.empty(kElementEpisodeNumber) && !IsBudgetExceeded())
+    SearchForEpisodeNumber();
+  if (last_stage == kParseStageSearchForEpisodeNumber)
+    return !IsBudgetExceeded();
+
+  // Each of the remaining stages scans the tokens a few times
+  if (!Spend(tokens_.size()))
+    return false;
+  SearchForAnimeTitle();
+
+  if (last_stage != kParseStageSearchForAnimeTitle) {
+    if (profile.parse_release_group() &&
+        elements_.empty(kElementReleaseGroup)) {
+      if (!Spend(tokens_.size()))
+        return false;
+      SearchForReleaseGroup();
+    }
+
+    if (last_stage != kParseStageSearchForReleaseGroup &&
+        profile.parse_episode_title() &&
+        !elements_.empty(kElementEpisodeNumber)) {
+      if (!Spend(tokens_.size()))
+        return false;
+      SearchForEpisodeTitle();
+    }
+  }
+
+  return !IsBudgetExceeded() &&
+         (!IsCategoryRequested(kElementAnimeTitle) ||
+          !elements_.empty(kElementAnimeTitle));
+}
+
 }  // namespace anitomy
 
 #endif  // ANITOMY_PARSER_H
\ No newline at end of file
@@ -34,21 +34,27 @@ size_t Parser::FindNumberInString(const string_t& str) {
 }
 
 string_t Parser::GetNumberFromOrdinal(const string_t& word) {
-  static /*const*/ std::map<string_t, string_t> ordinals;
-  {
-      ordinals.insert(std::pair<string_t, string_t>(L"1st", L"1")); ordinals.insert(std::pair<string_t, string_t>(L"First", L"1"));
-      ordinals.insert(std::pair<string_t, string_t>(L"2nd", L"2")); ordinals.insert(std::pair<string_t, string_t>(L"Second", L"2"));
-      ordinals.insert(std::pair<string_t, string_t>(L"3rd", L"3")); ordinals.insert(std::pair<string_t, string_t>(L"Third", L"3"));
-      ordinals.insert(std::pair<string_t, string_t>(L"4th", L"4")); ordinals.insert(std::pair<string_t, string_t>(L"Fourth", L"4"));
-      ordinals.insert(std::pair<string_t, string_t>(L"5th", L"5")); ordinals.insert(std::pair<string_t, string_t>(L"Fifth", L"5"));
-      ordinals.insert(std::pair<string_t, string_t>(L"6th", L"6")); ordinals.insert(std::pair<string_t, string_t>(L"Sixth", L"6"));
-      ordinals.insert(std::pair<string_t, string_t>(L"7th", L"7")); ordinals.insert(std::pair<string_t, string_t>(L"Seventh", L"7"));
-      ordinals.insert(std::pair<string_t, string_t>(L"8th", L"8")); ordinals.insert(std::pair<string_t, string_t>(L"Eighth", L"8"));
-      ordinals.insert(std::pair<string_t, string_t>(L"9th", L"9")); ordinals.insert(std::pair<string_t, string_t>(L"Ninth", L"9"));
+  struct ordinal_t {
+    const char_t* word;
+    const char_t* number;
   };
+  static const ordinal_t ordinals[] = {
+    {L"1st", L"1"}, {L"First", L"1"},
+    {L"2nd", L"2"}, {L"Second", L"2"},
+    {L"3rd", L"3"}, {L"Third", L"3"},
+    {L"4th", L"4"}, {L"Fourth", L"4"},
+    {L"5th", L"5"}, {L"Fifth", L"5"},
+    {L"6th", L"6"}, {L"Sixth", L"6"},
+    {L"7th", L"7"}, {L"Seventh", L"7"},
+    {L"8th", L"8"}, {L"Eighth", L"8"},
+    {L"9th", L"9"}, {L"Ninth", L"9"},
+  };
+
+  for (const ordinal_t* ordinal = ordinals; ordinal != ordinals + _countof(ordinals); ++ordinal)
+    if (word == ordinal->word)
+      return ordinal->number;
 
-  std::map<string_t, string_t>::const_iterator it = ordinals.find(word);
-  return it != ordinals.end() ? it->second : string_t();
+  return string_t();
 }
 
 bool Parser::IsCrc32(const string_t& str) {
@@ -94,7 +100,9 @@ bool Parser::IsResolution(const string_t& str) {
 
 void Parser::set_anime_season(token_iterator_t first, token_iterator_t second,
                               const string_t& content) {
-    elements_.insert(kElementAnimeSeason, content);
+    InsertElement(kElementAnimeSeason, content,
+                  first->content.find(content) != string_t::npos ? *first
+                                                                 : *second);
     first->category = kIdentifier;
     second->category = kIdentifier;
   };
@@ -180,9 +188,64 @@ bool Parser::IsElementCategorySingular(ElementCategory category) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// Finds where the value is in the token. Values are found from left to right
+// within a token, so the search starts after the previous one if it was in
+// the same token (e.g. the second "01" of "S01E01").
+void Parser::InsertElement(ElementCategory category, const string_t& value,
+                           const Token& token) {
+  TokenRange range(string_t::npos, value.size());
+
+  if (token.offset != string_t::npos) {
+    size_t position = string_t::npos;
+    if (token.offset == element_token_offset_)
+      position = token.content.find(value, element_token_end_);
+    if (position == string_t::npos)
+      position = token.content.find(value);
+    if (position != string_t::npos) {
+      range.offset = token.offset + position;
+      element_token_offset_ = token.offset;
+      element_token_end_ = position + value.size();
+    }
+  }
+
+  elements_.insert(category, value, range);
+}
+
 void Parser::BuildElement(ElementCategory category, bool keep_delimiters,
                           const token_iterator_t token_begin,
                           const token_iterator_t token_end) const {
+  // The tokens are identified all the same, for the stages that come after
+  if (!IsCategoryRequested(category)) {
+    for (token_iterator_t token = token_begin; token != token_end; ++token)
+      if (token->category == kUnknown)
+        token->category = kIdentifier;
+    return;
+  }
+
+  // The tokens are contiguous in the filename, unless an identifier or a
+  // split token is in between
+  TokenRange range(string_t::npos, 0);
+  if (token_begin != token_end)
+    range.offset = token_begin->offset;
+  for (token_iterator_t token = token_begin; token != token_end; ++token) {
+    if (range.offset == string_t::npos ||
+        token->offset != range.offset + range.size ||
+        token->category == kIdentifier || token->category == kInvalid) {
+      range.offset = string_t::npos;
+      break;
+    }
+    range.size += token->content.size();
+  }
+
+  // Nothing to rewrite, e.g. for the release group
+  if (keep_delimiters && range.offset != string_t::npos) {
+    for (token_iterator_t token = token_begin; token != token_end; ++token)
+      if (token->category == kUnknown)
+        token->category = kIdentifier;
+    elements_.insert(category, range);
+    return;
+  }
+
   string_t element;
 
   for (token_iterator_t token = token_begin; token != token_end; ++token) {
@@ -218,7 +281,7 @@ void Parser::BuildElement(ElementCategory category, bool keep_delimiters,
     TrimString(element, kDashesWithSpace.c_str());
 
   if (!element.empty())
-    elements_.insert(category, element);
+    elements_.insert(category, element, range);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@ namespace std
 #include "element.h"
 #include "keyword.h"
 #include "parser.h"
+#include "stats.h"
 #include "string.h"
 
 namespace anitomy {
@@ -45,7 +46,7 @@ bool Parser::SetEpisodeNumber(const string_t& number, Token& token,
     if (!IsValidEpisodeNumber(number))
       return false;
 
-  elements_.insert(kElementEpisodeNumber, number);
+  InsertElement(kElementEpisodeNumber, number, token);
   token.category = kIdentifier;
   return true;
 }
@@ -54,9 +55,9 @@ bool Parser::SetEpisodeNumber(const string_t& number, Token& token,
 
 bool Parser::NumberComesAfterEpisodePrefix(Token& token) {
   size_t number_begin = FindNumberInString(token.content);
-  string_t prefix = keyword_manager.Normalize(token.content.substr(0, number_begin));
+  string_t prefix = keywords_.Normalize(token.content.substr(0, number_begin));
 
-  if (keyword_manager.Find(kElementEpisodePrefix, prefix)) {
+  if (keywords_.Find(kElementEpisodePrefix, prefix)) {
     string_t number = token.content.substr(
         number_begin, token.content.length() - number_begin);
     if (!MatchEpisodePatterns(number, token))
@@ -90,16 +91,20 @@ bool Parser::NumberComesBeforeTotalNumber(const token_iterator_t token) {
 
 bool Parser::SearchForEpisodePatterns(std::vector<size_t>& tokens) {
   for (size_t token_index = 0; token_index < tokens.size(); ++token_index) {
-    token_container_t::iterator token = tokens_.begin() + token_index;
+    if (!Spend(1))
+      return false;
+    token_container_t::iterator token = tokens_.begin() + tokens.at(token_index);
     bool numeric_front = IsNumericChar(token->content.at(0));
 
     if (!numeric_front) {
       // e.g. "EP.01"
-      if (NumberComesAfterEpisodePrefix(*token))
+      if (ANITOMY_COUNT_RULE(stats_, kParseRuleEpisodePrefix,
+                             NumberComesAfterEpisodePrefix(*token)))
         return true;
     } else {
       // e.g. "8 of 12"
-      if (NumberComesBeforeTotalNumber(token))
+      if (ANITOMY_COUNT_RULE(stats_, kParseRuleTotalNumber,
+                             NumberComesBeforeTotalNumber(token)))
         return true;
     }
     // Look for other patterns
@@ -121,7 +126,7 @@ bool Parser::MatchSingleEpisodePattern(const string_t& word, Token& token) {
 
   if (std::regex_match(word, match_results, pattern)) {
     SetEpisodeNumber(match_results[1].str(), token, false);
-    elements_.insert(kElementReleaseVersion, match_results[2].str());
+    InsertElement(kElementReleaseVersion, match_results[2].str(), token);
     return true;
   }
 
@@ -140,7 +145,7 @@ bool Parser::MatchMultiEpisodePattern(const string_t& word, Token& token) {
       if (SetEpisodeNumber(lower_bound, token, true)) {
         SetEpisodeNumber(upper_bound, token, false);
         if (match_results[3].matched)
-          elements_.insert(kElementReleaseVersion, match_results[3].str());
+          InsertElement(kElementReleaseVersion, match_results[3].str(), token);
         return true;
       }
     }
@@ -158,9 +163,9 @@ bool Parser::MatchSeasonAndEpisodePattern(const string_t& word, Token& token) {
   regex_match_results_t match_results;
 
   if (std::regex_match(word, match_results, pattern)) {
-    elements_.insert(kElementAnimeSeason, match_results[1]);
+    InsertElement(kElementAnimeSeason, match_results[1], token);
     if (match_results[2].matched)
-      elements_.insert(kElementAnimeSeason, match_results[2]);
+      InsertElement(kElementAnimeSeason, match_results[2], token);
     SetEpisodeNumber(match_results[3], token, false);
     if (match_results[4].matched)
       SetEpisodeNumber(match_results[4], token, false);
@@ -177,9 +182,9 @@ bool Parser::MatchTypeAndEpisodePattern(const string_t& word, Token& token) {
   ElementCategory category = kElementAnimeType;
   KeywordOptions options;
 
-  if (keyword_manager.Find(keyword_manager.Normalize(prefix),
+  if (keywords_.Find(keywords_.Normalize(prefix),
                            category, options)) {
-    elements_.insert(kElementAnimeType, prefix);
+    InsertElement(kElementAnimeType, prefix, token);
     string_t number = word.substr(number_begin);
     if (MatchEpisodePatterns(number, token) ||
         SetEpisodeNumber(number, token, true)) {
@@ -187,9 +192,16 @@ bool Parser::MatchTypeAndEpisodePattern(const string_t& word, Token& token) {
       if (it != tokens_.end()) {
         // Split token (we do this last in order to avoid invalidating our
         // token reference earlier)
+        size_t prefix_offset = string_t::npos;
+        if (token.offset != string_t::npos && token.content == word) {
+          prefix_offset = token.offset;
+          token.offset += number_begin;
+        } else {
+          token.offset = string_t::npos;
+        }
         token.content = number;
         tokens_.insert(it, Token(options.identifiable ? kIdentifier : kUnknown,
-                                 prefix, token.enclosed));
+                                 prefix, token.enclosed, prefix_offset));
       }
       return true;
     }
@@ -239,7 +251,7 @@ bool Parser::MatchNumberSignPattern(const string_t& word, Token& token) {
       if (match_results[2].matched)
         SetEpisodeNumber(match_results[2].str(), token, false);
       if (match_results[3].matched)
-        elements_.insert(kElementReleaseVersion, match_results[3].str());
+        InsertElement(kElementReleaseVersion, match_results[3].str(), token);
       return true;
     }
   }
@@ -274,35 +286,43 @@ bool Parser::MatchEpisodePatterns(string_t word, Token& token) {
 
   // e.g. "01v2"
   if (numeric_front && numeric_back)
-    if (MatchSingleEpisodePattern(word, token))
+    if (ANITOMY_COUNT_RULE(stats_, kParseRuleSingleEpisode,
+                           MatchSingleEpisodePattern(word, token)))
       return true;
   // e.g. "01-02", "03-05v2"
   if (numeric_front && numeric_back)
-    if (MatchMultiEpisodePattern(word, token))
+    if (ANITOMY_COUNT_RULE(stats_, kParseRuleMultiEpisode,
+                           MatchMultiEpisodePattern(word, token)))
       return true;
   // e.g. "2x01", "S01E03", "S01-02xE001-150"
   if (numeric_back)
-    if (MatchSeasonAndEpisodePattern(word, token))
+    if (ANITOMY_COUNT_RULE(stats_, kParseRuleSeasonAndEpisode,
+                           MatchSeasonAndEpisodePattern(word, token)))
       return true;
   // e.g. "ED1", "OP4a", "OVA2"
   if (!numeric_front)
-    if (MatchTypeAndEpisodePattern(word, token))
+    if (ANITOMY_COUNT_RULE(stats_, kParseRuleTypeAndEpisode,
+                           MatchTypeAndEpisodePattern(word, token)))
       return true;
   // e.g. "07.5"
   if (numeric_front && numeric_back)
-    if (MatchFractionalEpisodePattern(word, token))
+    if (ANITOMY_COUNT_RULE(stats_, kParseRuleFractionalEpisode,
+                           MatchFractionalEpisodePattern(word, token)))
       return true;
   // e.g. "4a", "111C"
   if (numeric_front && !numeric_back)
-    if (MatchPartialEpisodePattern(word, token))
+    if (ANITOMY_COUNT_RULE(stats_, kParseRulePartialEpisode,
+                           MatchPartialEpisodePattern(word, token)))
       return true;
   // e.g. "#01", "#02-03v2"
   if (numeric_back)
-    if (MatchNumberSignPattern(word, token))
+    if (ANITOMY_COUNT_RULE(stats_, kParseRuleNumberSign,
+                           MatchNumberSignPattern(word, token)))
       return true;
   // U+8A71 is used as counter for stories, episodes of TV series, etc.
   if (numeric_front)
-    if (MatchJapaneseCounterPattern(word, token))
+    if (ANITOMY_COUNT_RULE(stats_, kParseRuleJapaneseCounter,
+                           MatchJapaneseCounterPattern(word, token)))
       return true;
 
   return false;
@@ -313,6 +333,8 @@ bool Parser::MatchEpisodePatterns(string_t word, Token& token) {
 bool Parser::SearchForEquivalentNumbers(std::vector<size_t>& tokens) {
   for (std::vector<size_t>::iterator token_index = tokens.begin();
        token_index != tokens.end(); ++token_index) {
+    if (!Spend(1))
+      return false;
     token_container_t::iterator token = tokens_.begin() + *token_index;
 
     if (IsTokenIsolated(token))
@@ -351,6 +373,8 @@ bool Parser::SearchForEquivalentNumbers(std::vector<size_t>& tokens) {
 bool Parser::SearchForIsolatedNumbers(std::vector<size_t>& tokens) {
   for (std::vector<size_t>::iterator token_index = tokens.begin();
        token_index != tokens.end(); ++token_index) {
+    if (!Spend(1))
+      return false;
     token_container_t::iterator token = tokens_.begin() + *token_index;
 
     if (!token->enclosed || !IsTokenIsolated(token))
@@ -366,6 +390,8 @@ bool Parser::SearchForIsolatedNumbers(std::vector<size_t>& tokens) {
 bool Parser::SearchForSeparatedNumbers(std::vector<size_t>& tokens) {
   for (std::vector<size_t>::iterator token_index = tokens.begin();
        token_index != tokens.end(); ++token_index) {
+    if (!Spend(1))
+      return false;
     token_container_t::iterator token = tokens_.begin() + *token_index;
     token_container_t::iterator previous_token = FindPreviousToken(tokens_, token, kFlagNotDelimiter);
 
@@ -388,6 +414,8 @@ bool is_not_enclosed(const Token& token) { return !is_enclosed(token); }
 
 bool Parser::SearchForLastNumber(std::vector<size_t>& tokens) {
   for (std::vector<size_t>::reverse_iterator it = tokens.rbegin(); it != tokens.rend(); ++it) {
+    if (!Spend(1))
+      return false;
     size_t token_index = *it;
     token_container_t::iterator token = tokens_.begin() + token_index;
 
@@ -0,0 +1,50 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_PROBES_H
+#define ANITOMY_PROBES_H
+
+// USDT (SystemTap SDT) probes, for tracing with perf, bpftrace or SystemTap.
+// They are compiled in only if ANITOMY_ENABLE_PROBES is nonzero, which
+// requires <sys/sdt.h> (systemtap-sdt-dev on Debian). A probe that nothing
+// is attached to is a single nop instruction.
+//
+// Provider "anitomy":
+//   parse__start(size_t filename_length)
+//   parse__done(size_t filename_length, int success)
+//   stage__start(int stage, const char* stage_name)
+//   stage__done(int stage, const char* stage_name)
+//
+// Stages are the values of ParseStage (see stats.h). See
+// tools/probes/stages.bt for an example.
+#ifndef ANITOMY_ENABLE_PROBES
+#define ANITOMY_ENABLE_PROBES 0
+#endif
+
+#if ANITOMY_ENABLE_PROBES
+#include <sys/sdt.h>
+#define ANITOMY_PROBE1(name, arg1) \
+    DTRACE_PROBE1(anitomy, name, arg1)
+#define ANITOMY_PROBE2(name, arg1, arg2) \
+    DTRACE_PROBE2(anitomy, name, arg1, arg2)
+#else
+#define ANITOMY_PROBE1(name, arg1)
+#define ANITOMY_PROBE2(name, arg1, arg2)
+#endif
+
+#endif  // ANITOMY_PROBES_H
\ No newline at end of file
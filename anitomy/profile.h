@@ -0,0 +1,101 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_PROFILE_H
+#define ANITOMY_PROFILE_H
+
+#include "options.h"
+#include "string.h"
+
+namespace anitomy {
+
+// A profile tells the tokenizer and the parser which stages to run, which
+// characters are delimiters, and which characters open a bracket:
+//
+//   bool parse_episode_number() const;
+//   bool parse_episode_title() const;
+//   bool parse_file_extension() const;
+//   bool parse_release_group() const;
+//   bool IsDelimiter(char_t c) const;
+//   char_t GetMatchingBracket(char_t c) const;  // L'\0' if not a bracket
+//
+// RuntimeProfile reads them from Options, and is what Anitomy uses. A
+// profile whose members are static and return constants fixes them at
+// compile time instead, so that the compiler can drop the stages that are
+// disabled and inline the character tests; see DefaultProfile and
+// BasicAnitomy.
+
+inline char_t GetDefaultMatchingBracket(char_t c) {
+  switch (c) {
+    case L'(': return L')';            // U+0028-U+0029 Parenthesis
+    case L'[': return L']';            // U+005B-U+005D Square bracket
+    case L'{': return L'}';            // U+007B-U+007D Curly bracket
+    case L'\u300C': return L'\u300D';  // Corner bracket
+    case L'\u300E': return L'\u300F';  // White corner bracket
+    case L'\u3010': return L'\u3011';  // Black lenticular bracket
+    case L'\uFF08': return L'\uFF09';  // Fullwidth parenthesis
+    default: return L'\0';
+  }
+}
+
+class RuntimeProfile {
+public:
+  explicit RuntimeProfile(const Options& options) : options_(options) {}
+
+  bool parse_episode_number() const { return options_.parse_episode_number; }
+  bool parse_episode_title() const { return options_.parse_episode_title; }
+  bool parse_file_extension() const { return options_.parse_file_extension; }
+  bool parse_release_group() const { return options_.parse_release_group; }
+
+  bool IsDelimiter(char_t c) const {
+    return options_.allowed_delimiters.find(c) != string_t::npos;
+  }
+
+  char_t GetMatchingBracket(char_t c) const {
+    return GetDefaultMatchingBracket(c);
+  }
+
+private:
+  const Options& options_;
+};
+
+// Same as the defaults of Options
+struct DefaultProfile {
+  static bool parse_episode_number() { return true; }
+  static bool parse_episode_title() { return true; }
+  static bool parse_file_extension() { return true; }
+  static bool parse_release_group() { return true; }
+
+  static bool IsDelimiter(char_t c) {
+    switch (c) {
+      case L' ': case L'_': case L'.': case L'&':
+      case L'+': case L',': case L'|':
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  static char_t GetMatchingBracket(char_t c) {
+    return GetDefaultMatchingBracket(c);
+  }
+};
+
+}  // namespace anitomy
+
+#endif  // ANITOMY_PROFILE_H
\ No newline at end of file
@@ -0,0 +1,278 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "serialization.h"
+
+namespace anitomy {
+
+static void AppendVarint(std::string& output, size_t value) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
+}
+
+static bool ReadVarint(const char* data, size_t size, size_t& position,
+                       size_t& value) {
+  value = 0;
+  for (size_t shift = 0; position < size && shift < 35; shift += 7) {
+    const unsigned char byte = static_cast<unsigned char>(data[position++]);
+    value |= static_cast<size_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ElementDictionary::ElementDictionary() {
+}
+
+static ElementDictionary CreateDefaultDictionary() {
+  // Never reorder or remove entries; doing so would break existing records.
+  static const char* const values[] = {
+    // File extension
+    "mkv", "mp4", "avi", "ogm", "wmv", "rmvb", "flv", "webm", "MKV", "MP4",
+    "AVI",
+    // Video resolution
+    "480p", "576p", "720p", "1080p", "2160p", "480P", "720P", "1080P",
+    "640x480", "704x396", "848x480", "1024x576", "1280x720", "1920x1080",
+    // Video term
+    "H.264", "H264", "h264", "h.264", "x264", "X264", "x.264", "AVC", "HEVC",
+    "H.265", "x265", "XviD", "Xvid", "DivX", "Hi10P", "Hi10p", "hi10p",
+    "10bit", "10-bit", "10Bit", "8bit", "8-bit", "HD", "SD",
+    // Audio term
+    "AAC", "aac", "AC3", "FLAC", "flac", "MP3", "OGG", "Vorbis", "DTS",
+    "AACx2", "2ch", "5.1", "5.1ch", "Dual Audio", "DualAudio",
+    // Source
+    "BD", "BDRip", "BluRay", "Blu-Ray", "Blu-ray", "DVD", "DVDRip",
+    "HDTV", "TV", "WEB", "WEBRip", "R2DVD",
+    // Subtitles, language and others
+    "RAW", "Raw", "SUB", "Dub", "ENG", "English", "VOSTFR", "Uncensored",
+    "OVA", "Movie", "Special", "Batch", "v2", "2",
+  };
+
+  ElementDictionary dictionary;
+  for (size_t i = 0; i < _countof(values); ++i)
+    dictionary.Add(values[i]);
+
+  return dictionary;
+}
+
+const ElementDictionary& ElementDictionary::Default() {
+  static const ElementDictionary dictionary = CreateDefaultDictionary();
+  return dictionary;
+}
+
+void ElementDictionary::Add(const std::string& value) {
+  // Duplicates keep their first index, so that old records stay readable
+  if (indices_.find(value) == indices_.end())
+    indices_.insert(std::make_pair(value, values_.size()));
+  values_.push_back(value);
+}
+
+bool ElementDictionary::Find(const std::string& value, size_t& index) const {
+  std::map<std::string, size_t>::const_iterator it = indices_.find(value);
+  if (it == indices_.end())
+    return false;
+  index = it->second;
+  return true;
+}
+
+const std::string* ElementDictionary::Get(size_t index) const {
+  return index < values_.size() ? &values_[index] : NULL;
+}
+
+size_t ElementDictionary::size() const {
+  return values_.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SerializeElements(const Elements& elements, std::string& output,
+                       const ElementDictionary* dictionary) {
+  output.push_back(static_cast<char>(kSerializationVersion));
+  AppendVarint(output, elements.size());
+
+  for (element_const_iterator_t element = elements.begin(); element != elements.end(); ++element) {
+    const std::string value = StringToUtf8(element->second);
+    size_t index = 0;
+    if (dictionary && dictionary->Find(value, index)) {
+      output.push_back(static_cast<char>(element->first | kSerializedDictionaryFlag));
+      AppendVarint(output, index);
+    } else {
+      output.push_back(static_cast<char>(element->first));
+      AppendVarint(output, value.size());
+      output.append(value);
+    }
+  }
+}
+
+bool DeserializeElements(const char* data, size_t size, Elements& elements,
+                         const ElementDictionary* dictionary) {
+  ElementsView view(data, size, dictionary);
+  if (!view.valid())
+    return false;
+
+  elements.clear();
+  size_t count = 0;
+  for (ElementsView::const_iterator element = view.begin(); element != view.end(); ++element) {
+    elements.insert(element->first, Utf8ToString(element->second.str()));
+    ++count;
+  }
+
+  return count == view.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ElementsView::ElementsView(const char* data, size_t size,
+                           const ElementDictionary* dictionary)
+    : data_(data),
+      size_(size),
+      count_(0),
+      elements_begin_(0),
+      dictionary_(dictionary),
+      valid_(false) {
+  if (size_ > 0 &&
+      static_cast<unsigned char>(data_[0]) == kSerializationVersion) {
+    elements_begin_ = 1;
+    valid_ = ReadVarint(data_, size_, elements_begin_, count_);
+  }
+}
+
+bool ElementsView::valid() const {
+  return valid_;
+}
+
+bool ElementsView::empty() const {
+  return count_ == 0;
+}
+
+size_t ElementsView::size() const {
+  return count_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ElementsView::const_iterator ElementsView::begin() const {
+  if (!valid_ || count_ == 0)
+    return end();
+  return const_iterator(this, elements_begin_, count_);
+}
+
+ElementsView::const_iterator ElementsView::end() const {
+  return const_iterator(this, size_, 0);
+}
+
+ElementsView::const_iterator::const_iterator(const ElementsView* view,
+                                             size_t position,
+                                             size_t remaining)
+    : view_(view),
+      position_(position),
+      next_position_(position),
+      remaining_(remaining) {
+  Decode();
+}
+
+ElementsView::const_iterator& ElementsView::const_iterator::operator++() {
+  position_ = next_position_;
+  --remaining_;
+  Decode();
+  return *this;
+}
+
+void ElementsView::const_iterator::Decode() {
+  // Truncated records end early rather than reading out of bounds
+  if (remaining_ == 0 ||
+      !view_->DecodeElement(position_, next_position_,
+                            value_.first, value_.second)) {
+    position_ = view_->size_;
+    remaining_ = 0;
+  }
+}
+
+bool ElementsView::DecodeElement(size_t position, size_t& next_position,
+                                 ElementCategory& category,
+                                 ElementValueView& value) const {
+  if (position >= size_)
+    return false;
+
+  const unsigned char tag = static_cast<unsigned char>(data_[position++]);
+  category = static_cast<ElementCategory>(tag & ~kSerializedDictionaryFlag);
+  if (category >= kElementIterateLast)
+    return false;
+
+  size_t length = 0;
+  if (!ReadVarint(data_, size_, position, length))
+    return false;
+
+  if (tag & kSerializedDictionaryFlag) {
+    const std::string* entry = dictionary_ ? dictionary_->Get(length) : NULL;
+    if (!entry)
+      return false;
+    value = ElementValueView(entry->data(), entry->size());
+  } else {
+    if (length > size_ - position)
+      return false;
+    value = ElementValueView(data_ + position, length);
+    position += length;
+  }
+
+  next_position = position;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ElementValueView ElementsView::get(ElementCategory category) const {
+  for (const_iterator element = begin(); element != end(); ++element)
+    if (element->first == category)
+      return element->second;
+
+  return ElementValueView();
+}
+
+std::vector<ElementValueView> ElementsView::get_all(
+    ElementCategory category) const {
+  std::vector<ElementValueView> values;
+
+  for (const_iterator element = begin(); element != end(); ++element)
+    if (element->first == category)
+      values.push_back(element->second);
+
+  return values;
+}
+
+size_t ElementsView::count(ElementCategory category) const {
+  size_t count = 0;
+
+  for (const_iterator element = begin(); element != end(); ++element)
+    if (element->first == category)
+      ++count;
+
+  return count;
+}
+
+bool ElementsView::empty(ElementCategory category) const {
+  return get(category).data == NULL;
+}
+
+}  // namespace anitomy
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_SERIALIZATION_H
+#define ANITOMY_SERIALIZATION_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "element.h"
+#include "string.h"
+
+namespace anitomy {
+
+// Binary encoding of Elements (version 1):
+//
+//   uint8   version
+//   varint  element count
+//   for each element:
+//     uint8   category, with kSerializedDictionaryFlag set if the value is a
+//             dictionary reference
+//     varint  dictionary index, or length of the UTF-8 value that follows
+//
+// Varints are unsigned LEB128. Records don't carry their own size; callers
+// that store many of them are expected to frame them.
+
+const unsigned char kSerializationVersion = 1;
+const unsigned char kSerializedDictionaryFlag = 0x80;
+
+// Common values that can be stored as a reference instead of a string. Both
+// sides must use identical dictionaries; entries may only be appended.
+class ElementDictionary {
+public:
+  ElementDictionary();
+
+  // Video terms, audio terms, sources, resolutions and file extensions that
+  // are frozen as a part of format version 1
+  static const ElementDictionary& Default();
+
+  void Add(const std::string& value);
+
+  bool Find(const std::string& value, size_t& index) const;
+  const std::string* Get(size_t index) const;
+  size_t size() const;
+
+private:
+  std::map<std::string, size_t> indices_;
+  std::vector<std::string> values_;
+};
+
+void SerializeElements(const Elements& elements, std::string& output,
+                       const ElementDictionary* dictionary = NULL);
+bool DeserializeElements(const char* data, size_t size, Elements& elements,
+                         const ElementDictionary* dictionary = NULL);
+
+// Points into a serialized record or a dictionary; no copies are made
+struct ElementValueView {
+  ElementValueView() : data(NULL), size(0) {}
+  ElementValueView(const char* data, size_t size) : data(data), size(size) {}
+
+  bool empty() const { return size == 0; }
+  std::string str() const { return std::string(data, size); }
+
+  const char* data;
+  size_t size;
+};
+
+// Answers queries by walking the record in place, without deserializing it.
+// The record (and the dictionary) must outlive the view.
+class ElementsView {
+public:
+  ElementsView(const char* data, size_t size,
+               const ElementDictionary* dictionary = NULL);
+
+  class const_iterator {
+  public:
+    typedef std::pair<ElementCategory, ElementValueView> value_type;
+
+    const value_type& operator*() const { return value_; }
+    const value_type* operator->() const { return &value_; }
+    const_iterator& operator++();
+    bool operator==(const const_iterator& it) const { return position_ == it.position_; }
+    bool operator!=(const const_iterator& it) const { return position_ != it.position_; }
+
+  private:
+    friend class ElementsView;
+    const_iterator(const ElementsView* view, size_t position, size_t remaining);
+    void Decode();
+
+    const ElementsView* view_;
+    size_t position_;
+    size_t next_position_;
+    size_t remaining_;
+    value_type value_;
+  };
+
+  // Returns false if the record is malformed or of an unknown version
+  bool valid() const;
+
+  // Capacity
+  bool empty() const;
+  size_t size() const;
+
+  // Iterators
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Value access
+  ElementValueView get(ElementCategory category) const;
+  std::vector<ElementValueView> get_all(ElementCategory category) const;
+
+  // Lookup
+  size_t count(ElementCategory category) const;
+  bool empty(ElementCategory category) const;
+
+private:
+  bool DecodeElement(size_t position, size_t& next_position,
+                     ElementCategory& category, ElementValueView& value) const;
+
+  const char* data_;
+  size_t size_;
+  size_t count_;
+  size_t elements_begin_;
+  const ElementDictionary* dictionary_;
+  bool valid_;
+};
+
+}  // namespace anitomy
+
+#endif  // ANITOMY_SERIALIZATION_H
\ No newline at end of file
@@ -0,0 +1,155 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "stats.h"
+
+#ifdef _MSC_VER
+#define ANITOMY_THREAD_LOCAL __declspec(thread)
+#else
+#define ANITOMY_THREAD_LOCAL __thread
+#endif
+
+namespace anitomy {
+
+// Zero-initialized, so that it can be used before any constructor runs
+static ANITOMY_THREAD_LOCAL AllocationCounters allocation_counters;
+
+const char* ParseStageName(ParseStage stage) {
+  static const char* const names[] = {
+    "total",
+    "remove_extension",
+    "remove_ignored_strings",
+    "normalize_width",
+    "tokenize",
+    "peek",
+    "search_for_keywords",
+    "search_for_isolated_numbers",
+    "search_for_episode_number",
+    "search_for_anime_title",
+    "search_for_release_group",
+    "search_for_episode_title",
+  };
+
+  return stage < kParseStageCount ? names[stage] : "";
+}
+
+const char* ParseRuleName(ParseRule rule) {
+  static const char* const names[] = {
+    "episode_prefix",
+    "total_number",
+    "single_episode",
+    "multi_episode",
+    "season_and_episode",
+    "type_and_episode",
+    "fractional_episode",
+    "partial_episode",
+    "number_sign",
+    "japanese_counter",
+    "equivalent_numbers",
+    "separated_numbers",
+    "isolated_numbers",
+    "last_number",
+  };
+
+  return rule < kParseRuleCount ? names[rule] : "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ParseStats::ParseStats() {
+  clear();
+}
+
+void ParseStats::clear() {
+  for (int i = 0; i < kParseStageCount; ++i) {
+    nanoseconds[i] = 0;
+    calls[i] = 0;
+    allocations[i] = 0;
+    allocated_bytes[i] = 0;
+  }
+  for (int i = 0; i < kParseRuleCount; ++i) {
+    rule_attempts[i] = 0;
+    rule_hits[i] = 0;
+    rule_depth[i] = 0;
+  }
+  peak_live_bytes = 0;
+  parses = 0;
+}
+
+void ParseStats::Add(const ParseStats& stats) {
+  for (int i = 0; i < kParseStageCount; ++i) {
+    nanoseconds[i] += stats.nanoseconds[i];
+    calls[i] += stats.calls[i];
+    allocations[i] += stats.allocations[i];
+    allocated_bytes[i] += stats.allocated_bytes[i];
+  }
+  for (int i = 0; i < kParseRuleCount; ++i) {
+    rule_attempts[i] += stats.rule_attempts[i];
+    rule_hits[i] += stats.rule_hits[i];
+    rule_depth[i] += stats.rule_depth[i];
+  }
+  if (stats.peak_live_bytes > peak_live_bytes)
+    peak_live_bytes = stats.peak_live_bytes;
+  parses += stats.parses;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned long long GetStatsClock() {
+#ifdef _WIN32
+  static LARGE_INTEGER frequency = {0};
+  if (!frequency.QuadPart)
+    QueryPerformanceFrequency(&frequency);
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter(&counter);
+  return static_cast<unsigned long long>(
+      counter.QuadPart / static_cast<double>(frequency.QuadPart) * 1e9);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<unsigned long long>(ts.tv_sec) * 1000000000ULL +
+         ts.tv_nsec;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+AllocationCounters& GetAllocationCounters() {
+  return allocation_counters;
+}
+
+void RecordAllocation(size_t size) {
+  AllocationCounters& counters = allocation_counters;
+  counters.allocations += 1;
+  counters.bytes += size;
+  counters.live_bytes += size;
+  if (counters.live_bytes > counters.peak_live_bytes)
+    counters.peak_live_bytes = counters.live_bytes;
+}
+
+void RecordDeallocation(size_t size) {
+  allocation_counters.live_bytes -= size;
+}
+
+}  // namespace anitomy
\ No newline at end of file
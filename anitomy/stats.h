@@ -0,0 +1,191 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_STATS_H
+#define ANITOMY_STATS_H
+
+#include <cstddef>
+
+#include "probes.h"
+
+// Per-stage timing, rule counters and allocation accounting are compiled in
+// only if ANITOMY_ENABLE_STATS is nonzero. Otherwise ParseStats is still
+// available, but every counter stays at zero and no clock is ever read.
+//
+// Allocations are counted by replacing the global operator new and delete
+// (see allocation_hook.cpp). Programs that bring their own allocator can
+// define ANITOMY_DISABLE_ALLOCATION_HOOK, and call RecordAllocation() and
+// RecordDeallocation() from it instead. The over-aligned forms of C++17
+// (those that take a std::align_val_t) are left to the standard library and
+// are not counted; nothing in the parser asks for them.
+#ifndef ANITOMY_ENABLE_STATS
+#define ANITOMY_ENABLE_STATS 0
+#endif
+
+namespace anitomy {
+
+enum ParseStage {
+  kParseStageTotal,
+  kParseStageRemoveExtension,
+  kParseStageRemoveIgnoredStrings,
+  kParseStageNormalizeWidth,
+  kParseStageTokenize,
+  kParseStagePeek,  // Included in kParseStageTokenize
+  kParseStageSearchForKeywords,
+  kParseStageSearchForIsolatedNumbers,
+  kParseStageSearchForEpisodeNumber,
+  kParseStageSearchForAnimeTitle,
+  kParseStageSearchForReleaseGroup,
+  kParseStageSearchForEpisodeTitle,
+  kParseStageCount
+};
+
+// Heuristics that can decide the episode number, in the order in which they
+// are tried
+enum ParseRule {
+  kParseRuleEpisodePrefix,
+  kParseRuleTotalNumber,
+  kParseRuleSingleEpisode,
+  kParseRuleMultiEpisode,
+  kParseRuleSeasonAndEpisode,
+  kParseRuleTypeAndEpisode,
+  kParseRuleFractionalEpisode,
+  kParseRulePartialEpisode,
+  kParseRuleNumberSign,
+  kParseRuleJapaneseCounter,
+  kParseRuleEquivalentNumbers,
+  kParseRuleSeparatedNumbers,
+  kParseRuleIsolatedNumbers,
+  kParseRuleLastNumber,
+  kParseRuleCount
+};
+
+const char* ParseStageName(ParseStage stage);
+const char* ParseRuleName(ParseRule rule);
+
+struct ParseStats {
+  ParseStats();
+
+  void clear();
+  void Add(const ParseStats& stats);
+
+  unsigned long long nanoseconds[kParseStageCount];
+  unsigned long long calls[kParseStageCount];
+
+  // A rule is attempted when its matcher runs, and hits if it decides an
+  // element. Depth is the number of attempts made in the same parse before
+  // the hit, so depth / hits is the average cost of reaching a rule.
+  unsigned long long rule_attempts[kParseRuleCount];
+  unsigned long long rule_hits[kParseRuleCount];
+  unsigned long long rule_depth[kParseRuleCount];
+
+  // Heap allocations made in each stage, and the highest number of bytes
+  // that were live at once during a parse, above what was live before it.
+  // Aggregates keep the highest peak of any single parse.
+  unsigned long long allocations[kParseStageCount];
+  unsigned long long allocated_bytes[kParseStageCount];
+  unsigned long long peak_live_bytes;
+
+  unsigned long long parses;
+};
+
+// Monotonic, in nanoseconds
+unsigned long long GetStatsClock();
+
+// Counters of the calling thread. Anitomy::Parse resets the peak to the
+// current number of live bytes when it starts.
+struct AllocationCounters {
+  unsigned long long allocations;
+  unsigned long long bytes;
+  long long live_bytes;  // Negative if this thread frees memory of others
+  long long peak_live_bytes;
+};
+
+AllocationCounters& GetAllocationCounters();
+void RecordAllocation(size_t size);
+void RecordDeallocation(size_t size);
+
+// Adds the lifetime of the timer, and the allocations made meanwhile, to a
+// stage. Also marks the stage boundaries for tracing, if probes are enabled.
+class StageTimer {
+public:
+  StageTimer(ParseStats* stats, ParseStage stage)
+      : stats_(stats), stage_(stage), start_(0), allocations_(0), bytes_(0) {
+    ANITOMY_PROBE2(stage__start, static_cast<int>(stage_),
+                   ParseStageName(stage_));
+    if (stats_) {
+      const AllocationCounters& counters = GetAllocationCounters();
+      allocations_ = counters.allocations;
+      bytes_ = counters.bytes;
+      start_ = GetStatsClock();
+    }
+  }
+  ~StageTimer() {
+    if (stats_) {
+      stats_->nanoseconds[stage_] += GetStatsClock() - start_;
+      stats_->calls[stage_] += 1;
+      const AllocationCounters& counters = GetAllocationCounters();
+      stats_->allocations[stage_] += counters.allocations - allocations_;
+      stats_->allocated_bytes[stage_] += counters.bytes - bytes_;
+    }
+    ANITOMY_PROBE2(stage__done, static_cast<int>(stage_),
+                   ParseStageName(stage_));
+  }
+
+private:
+  StageTimer(const StageTimer&);
+  StageTimer& operator=(const StageTimer&);
+
+  ParseStats* stats_;
+  ParseStage stage_;
+  unsigned long long start_;
+  unsigned long long allocations_;
+  unsigned long long bytes_;
+};
+
+// Records the outcome of a rule and passes it through
+inline bool CountRule(ParseStats* stats, ParseRule rule, bool hit) {
+  if (stats) {
+    if (hit) {
+      for (int i = 0; i < kParseRuleCount; ++i)
+        stats->rule_depth[rule] += stats->rule_attempts[i];
+      stats->rule_hits[rule] += 1;
+    }
+    stats->rule_attempts[rule] += 1;
+  }
+  return hit;
+}
+
+}  // namespace anitomy
+
+#if ANITOMY_ENABLE_STATS
+#define ANITOMY_TIME_STAGE(stats, stage) \
+    anitomy::StageTimer stage_timer(stats, stage)
+#define ANITOMY_COUNT_RULE(stats, rule, condition) \
+    anitomy::CountRule(stats, rule, (condition))
+#else
+#if ANITOMY_ENABLE_PROBES
+#define ANITOMY_TIME_STAGE(stats, stage) \
+    anitomy::StageTimer stage_timer(NULL, stage)
+#else
+#define ANITOMY_TIME_STAGE(stats, stage)
+#endif
+#define ANITOMY_COUNT_RULE(stats, rule, condition) (condition)
+#endif
+
+#endif  // ANITOMY_STATS_H
\ No newline at end of file
@@ -17,9 +17,11 @@
 */
 
 #include <algorithm>
-#include <functional>
+#include <cwchar>
 
+#include "case_table.h"
 #include "string.h"
+#include "width_table.h"
 
 namespace anitomy {
 
@@ -79,24 +81,34 @@ bool IsNumericString(const string_t& str) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-inline wchar_t ToLower(const wchar_t c) {
-  return (c >= L'a' && c <= L'z') ? c :
-         (c >= L'A' && c <= L'Z') ? (c + (L'a' - L'A')) :
-         static_cast<wchar_t>(towlower(c));
+// Unlike towupper and towlower, the result doesn't depend on the locale
+static char_t MapCase(const char_t c, const short* deltas,
+                      const unsigned char (*indexes)[256]) {
+  const int page = GetCasePage(static_cast<unsigned long>(c));
+  if (page < 0)
+    return c;
+  return static_cast<char_t>(c + deltas[indexes[page][c & 0xFF]]);
 }
 
-struct ToUpper : public std::unary_function<char_t, char_t> {
-  wchar_t operator ()(const wchar_t c) const {
-    return (c >= L'A' && c <= L'Z') ? c :
-           (c >= L'a' && c <= L'z') ? (c + (L'A' - L'a')) :
-           static_cast<wchar_t>(towupper(c));
-  }
-};
+// ASCII doesn't need the tables. Case folding goes through the upper case,
+// so that e.g. final and medial sigma are equal.
+inline char_t FoldCase(const char_t c) {
+  if (c < 0x80)
+    return static_cast<unsigned long>(c - L'A') < 26 ? c + (L'a' - L'A') : c;
+  return MapCase(MapCase(c, upper_deltas, upper_indexes),
+                 lower_deltas, lower_indexes);
+}
+
+inline char_t ToUpper(const char_t c) {
+  if (c < 0x80)
+    return static_cast<unsigned long>(c - L'a') < 26 ? c + (L'A' - L'a') : c;
+  return MapCase(c, upper_deltas, upper_indexes);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 inline bool IsCharEqualTo(const char_t c1, const char_t c2) {
-  return ToLower(c1) == ToLower(c2);
+  return c1 == c2 || FoldCase(c1) == FoldCase(c2);
 }
 
 bool IsStringEqualTo(const string_t& str1, const string_t& str2) {
@@ -126,7 +138,8 @@ void EraseString(string_t& str, const string_t& erase_this) {
 }
 
 void StringToUpper(string_t& str) {
-  std::transform(str.begin(), str.end(), str.begin(), ToUpper());
+  for (string_t::iterator it = str.begin(); it != str.end(); ++it)
+    *it = ToUpper(*it);
 }
 
 string_t StringToUpperCopy(string_t str) {
@@ -134,6 +147,51 @@ string_t StringToUpperCopy(string_t str) {
   return str;
 }
 
+// Returns the character that NFKC maps a width variant to, or the character
+// itself
+inline char_t MapWidth(const char_t c) {
+  if (c == L'\u3000')  // Ideographic space
+    return L' ';
+  if (static_cast<unsigned long>(c) - 0xFF00 < 0x100) {
+    const unsigned short mapped = width_forms[c & 0xFF];
+    if (mapped)
+      return static_cast<char_t>(mapped);
+  }
+  return c;
+}
+
+size_t FindWidthVariant(const char_t* str, size_t length) {
+  // Every variant is at U+3000 or above. A block of characters that are
+  // all below U+2000 has no bits above them when OR'ed together, which is a
+  // loop that the compiler can vectorize, so that text without any variants
+  // costs little more than reading it once.
+  const size_t block_size = 16;
+  size_t i = 0;
+  for (; i + block_size <= length; i += block_size) {
+    char_t bits = 0;
+    for (size_t j = 0; j < block_size; ++j)
+      bits |= str[i + j];
+    if (static_cast<unsigned long>(bits) < 0x2000)
+      continue;
+    for (size_t j = i; j < i + block_size; ++j)
+      if (MapWidth(str[j]) != str[j])
+        return j;
+  }
+  for (; i < length; ++i)
+    if (MapWidth(str[i]) != str[i])
+      return i;
+  return string_t::npos;
+}
+
+bool NormalizeWidth(string_t& str) {
+  size_t i = FindWidthVariant(str.data(), str.size());
+  if (i == string_t::npos)
+    return false;
+  for (; i < str.size(); ++i)
+    str[i] = MapWidth(str[i]);
+  return true;
+}
+
 void TrimString(string_t& str, const char_t trim_chars[]) {
   if (str.empty())
     return;
@@ -150,4 +208,117 @@ void TrimString(string_t& str, const char_t trim_chars[]) {
   str.erase(0, pos_begin);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t GetUtf8Length(unsigned long c) {
+  return c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+}
+
+static void WriteCodePoint(char* output, unsigned long c) {
+  switch (GetUtf8Length(c)) {
+    case 1:
+      output[0] = static_cast<char>(c);
+      break;
+    case 2:
+      output[0] = static_cast<char>(0xC0 | (c >> 6));
+      output[1] = static_cast<char>(0x80 | (c & 0x3F));
+      break;
+    case 3:
+      output[0] = static_cast<char>(0xE0 | (c >> 12));
+      output[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      output[2] = static_cast<char>(0x80 | (c & 0x3F));
+      break;
+    default:
+      output[0] = static_cast<char>(0xF0 | (c >> 18));
+      output[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+      output[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      output[3] = static_cast<char>(0x80 | (c & 0x3F));
+      break;
+  }
+}
+
+static void AppendCodePoint(string_t& str, unsigned long c) {
+  if (sizeof(char_t) == 2 && c >= 0x10000) {  // UTF-16 surrogate pair
+    c -= 0x10000;
+    str.push_back(static_cast<char_t>(0xD800 | (c >> 10)));
+    str.push_back(static_cast<char_t>(0xDC00 | (c & 0x3FF)));
+  } else {
+    str.push_back(static_cast<char_t>(c));
+  }
+}
+
+size_t StringToUtf8(const char_t* str, size_t length, char* output,
+                    size_t size) {
+  size_t required = 0;
+
+  for (const char_t* it = str; it != str + length; ++it) {
+    unsigned long c = static_cast<unsigned long>(*it);
+    if (sizeof(char_t) == 2)
+      c &= 0xFFFF;
+    if (c >= 0xD800 && c <= 0xDBFF && it + 1 != str + length) {
+      const unsigned long low = static_cast<unsigned long>(*(it + 1)) & 0xFFFF;
+      if (low >= 0xDC00 && low <= 0xDFFF) {
+        c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+        ++it;
+      }
+    }
+    if (c > 0x10FFFF)
+      c = 0xFFFD;  // Replacement character
+    // Nothing is written after the first code point that doesn't fit
+    const size_t c_length = GetUtf8Length(c);
+    if (required + c_length <= size)
+      WriteCodePoint(output + required, c);
+    else
+      size = 0;
+    required += c_length;
+  }
+
+  return required;
+}
+
+std::string StringToUtf8(const string_t& str) {
+  std::string result(StringToUtf8(str.data(), str.size(), NULL, 0), '\0');
+  if (!result.empty())
+    StringToUtf8(str.data(), str.size(), &result[0], result.size());
+  return result;
+}
+
+void Utf8ToString(const char* str, size_t length, string_t& output) {
+  output.clear();
+
+  for (size_t i = 0; i < length; ) {
+    const unsigned char lead = static_cast<unsigned char>(str[i]);
+    size_t c_length = lead < 0x80 ? 1 :
+                      (lead & 0xE0) == 0xC0 ? 2 :
+                      (lead & 0xF0) == 0xE0 ? 3 :
+                      (lead & 0xF8) == 0xF0 ? 4 : 0;
+    unsigned long c = c_length == 1 ? lead :
+                      c_length == 2 ? (lead & 0x1F) :
+                      c_length == 3 ? (lead & 0x0F) : (lead & 0x07);
+
+    bool valid = c_length > 0 && i + c_length <= length;
+    for (size_t j = 1; valid && j < c_length; ++j) {
+      const unsigned char next = static_cast<unsigned char>(str[i + j]);
+      if ((next & 0xC0) != 0x80)
+        valid = false;
+      c = (c << 6) | (next & 0x3F);
+    }
+
+    if (valid) {
+      AppendCodePoint(output, c);
+      i += c_length;
+    } else {
+      AppendCodePoint(output, 0xFFFD);  // Replacement character
+      ++i;
+    }
+  }
+}
+
+string_t Utf8ToString(const std::string& str) {
+  string_t result;
+  result.reserve(str.size());
+  Utf8ToString(str.data(), str.size(), result);
+  return result;
+}
+
 }  // namespace anitomy
\ No newline at end of file
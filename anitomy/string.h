@@ -21,11 +21,24 @@
 
 #include <string>
 
+#ifndef _countof  // MSVC-specific
+#define _countof(array) (sizeof(array) / sizeof(array[0]))
+#endif
+
 namespace anitomy {
 
 typedef wchar_t char_t;
 typedef std::basic_string<char_t> string_t;
 
+// A string in a buffer of the caller, for what would be a
+// std::basic_string_view<char_t> in C++17
+struct StringView {
+  StringView(const char_t* data, size_t size) : data(data), size(size) {}
+
+  const char_t* data;
+  size_t size;
+};
+
 bool IsAlphanumericChar(const char_t c);
 bool IsNotAlphanumericChar(const char_t c);
 bool IsHexadecimalChar(const char_t c);
@@ -46,6 +59,25 @@ void EraseString(string_t& str, const string_t& erase_this);
 string_t StringToUpperCopy(string_t str);
 void TrimString(string_t& str, const char_t trim_chars[] = L" ");
 
+// Maps the fullwidth and halfwidth forms (e.g. fullwidth digits and Latin
+// letters to ASCII) and the ideographic space as NFKC would, for the
+// characters that it maps to a single one. Offsets into the result are
+// offsets into the original as well. NormalizeWidth returns whether anything
+// was changed, and FindWidthVariant the position of the first character that
+// would be, or npos.
+size_t FindWidthVariant(const char_t* str, size_t length);
+bool NormalizeWidth(string_t& str);
+
+std::string StringToUtf8(const string_t& str);
+string_t Utf8ToString(const std::string& str);
+
+// Without allocating: StringToUtf8 returns the size that the whole string
+// needs, and writes only as much of it as fits in the output. Utf8ToString
+// reuses the capacity of the output.
+size_t StringToUtf8(const char_t* str, size_t length, char* output,
+                    size_t size);
+void Utf8ToString(const char* str, size_t length, string_t& output);
+
 }  // namespace anitomy
 
 #endif  // ANITOMY_STRING_H
\ No newline at end of file
@@ -0,0 +1,222 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <limits>
+
+#include "string_pool.h"
+
+namespace anitomy {
+
+const string_id_t kEmptySlot = static_cast<string_id_t>(-1);
+
+static const unsigned int kMaxOffset =
+    std::numeric_limits<unsigned int>::max();
+
+// FNV-1a
+static size_t HashString(const char* data, size_t size) {
+  unsigned int hash = 2166136261U;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+StringPool::StringPool() {
+  clear();
+}
+
+bool StringPool::Intern(const std::string& value, string_id_t& id) {
+  ++lookups_;
+  requested_bytes_ += value.size();
+
+  const size_t hash = HashString(value.data(), value.size());
+  size_t slot = FindSlot(value.data(), value.size(), hash);
+  if (slots_[slot] != kEmptySlot) {
+    id = slots_[slot];
+    return true;
+  }
+
+  // kEmptySlot is not a valid ID
+  if (value.size() > kMaxOffset - arena_.size() || size() >= kEmptySlot)
+    return false;
+
+  // Keep the load factor below 1/2
+  if ((size() + 1) * 2 > slots_.size()) {
+    Rehash(slots_.size() * 2);
+    slot = FindSlot(value.data(), value.size(), hash);
+  }
+
+  id = static_cast<string_id_t>(size());
+  arena_.append(value);
+  offsets_.push_back(static_cast<unsigned int>(arena_.size()));
+  hashes_.push_back(hash);
+  slots_[slot] = id;
+
+  return true;
+}
+
+bool StringPool::Intern(const string_t& value, string_id_t& id) {
+  return Intern(StringToUtf8(value), id);
+}
+
+bool StringPool::Find(const std::string& value, string_id_t& id) const {
+  const size_t slot = FindSlot(value.data(), value.size(),
+                               HashString(value.data(), value.size()));
+  if (slots_[slot] == kEmptySlot)
+    return false;
+  id = slots_[slot];
+  return true;
+}
+
+ElementValueView StringPool::Get(string_id_t id) const {
+  return ElementValueView(arena_.data() + offsets_[id],
+                          offsets_[id + 1] - offsets_[id]);
+}
+
+size_t StringPool::FindSlot(const char* data, size_t size,
+                            size_t hash) const {
+  const size_t mask = slots_.size() - 1;
+
+  for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+    const string_id_t id = slots_[slot];
+    if (id == kEmptySlot)
+      return slot;
+    if (hashes_[id] == hash && offsets_[id + 1] - offsets_[id] == size &&
+        std::memcmp(arena_.data() + offsets_[id], data, size) == 0)
+      return slot;
+  }
+}
+
+void StringPool::Rehash(size_t slot_count) {
+  slots_.assign(slot_count, kEmptySlot);
+
+  const size_t mask = slot_count - 1;
+  for (string_id_t id = 0; id < size(); ++id) {
+    size_t slot = hashes_[id] & mask;
+    while (slots_[slot] != kEmptySlot)
+      slot = (slot + 1) & mask;
+    slots_[slot] = id;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StringPool::clear() {
+  arena_.clear();
+  offsets_.assign(1, 0);
+  hashes_.clear();
+  slots_.assign(16, kEmptySlot);
+  lookups_ = 0;
+  requested_bytes_ = 0;
+}
+
+bool StringPool::empty() const {
+  return hashes_.empty();
+}
+
+size_t StringPool::size() const {
+  return hashes_.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+size_t StringPool::lookups() const {
+  return lookups_;
+}
+
+size_t StringPool::requested_bytes() const {
+  return requested_bytes_;
+}
+
+size_t StringPool::stored_bytes() const {
+  return arena_.size();
+}
+
+size_t StringPool::memory_usage() const {
+  return sizeof(*this) + arena_.capacity() +
+         offsets_.capacity() * sizeof(unsigned int) +
+         hashes_.capacity() * sizeof(size_t) +
+         slots_.capacity() * sizeof(string_id_t);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+InternedElements::InternedElements() {
+}
+
+bool InternedElements::assign(const Elements& elements, StringPool& pool) {
+  elements_.clear();
+  elements_.reserve(elements.size());
+
+  for (element_const_iterator_t element = elements.begin(); element != elements.end(); ++element) {
+    string_id_t id;
+    if (!pool.Intern(element->second, id)) {
+      elements_.clear();
+      return false;
+    }
+    elements_.push_back(std::make_pair(element->first, id));
+  }
+
+  return true;
+}
+
+void InternedElements::restore(const StringPool& pool,
+                               Elements& elements) const {
+  elements.clear();
+
+  for (const_iterator element = elements_.begin(); element != elements_.end(); ++element)
+    elements.insert(element->first,
+                    Utf8ToString(pool.Get(element->second).str()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool InternedElements::empty() const {
+  return elements_.empty();
+}
+
+size_t InternedElements::size() const {
+  return elements_.size();
+}
+
+InternedElements::const_iterator InternedElements::begin() const {
+  return elements_.begin();
+}
+
+InternedElements::const_iterator InternedElements::end() const {
+  return elements_.end();
+}
+
+ElementValueView InternedElements::get(ElementCategory category,
+                                       const StringPool& pool) const {
+  for (const_iterator element = elements_.begin(); element != elements_.end(); ++element)
+    if (element->first == category)
+      return pool.Get(element->second);
+
+  return ElementValueView();
+}
+
+size_t InternedElements::memory_usage() const {
+  return sizeof(*this) + elements_.capacity() * sizeof(value_type);
+}
+
+}  // namespace anitomy
\ No newline at end of file
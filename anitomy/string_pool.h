@@ -0,0 +1,103 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_STRING_POOL_H
+#define ANITOMY_STRING_POOL_H
+
+#include <string>
+#include <vector>
+
+#include "element.h"
+#include "serialization.h"
+#include "string.h"
+
+namespace anitomy {
+
+typedef unsigned int string_id_t;
+
+// Stores each distinct UTF-8 value once, in a single arena, and hands out
+// small IDs for them. IDs are dense and stay valid until clear() is called.
+// Offsets and IDs are 32 bits, so Intern() fails once the arena or the number
+// of values would exceed that. A pool is not thread-safe; give each batch or
+// cache its own.
+class StringPool {
+public:
+  StringPool();
+
+  bool Intern(const std::string& value, string_id_t& id);
+  bool Intern(const string_t& value, string_id_t& id);
+  bool Find(const std::string& value, string_id_t& id) const;
+
+  // Views are invalidated by the next call to Intern()
+  ElementValueView Get(string_id_t id) const;
+
+  void clear();
+  bool empty() const;
+  size_t size() const;
+
+  // Statistics
+  size_t lookups() const;          // Calls to Intern()
+  size_t requested_bytes() const;  // Sum of the sizes of interned values
+  size_t stored_bytes() const;     // Sum of the sizes of distinct values
+  size_t memory_usage() const;
+
+private:
+  size_t FindSlot(const char* data, size_t size, size_t hash) const;
+  void Rehash(size_t slot_count);
+
+  std::string arena_;
+  std::vector<unsigned int> offsets_;  // size() + 1 entries
+  std::vector<size_t> hashes_;
+  std::vector<string_id_t> slots_;     // Open addressing, linear probing
+  size_t lookups_;
+  size_t requested_bytes_;
+};
+
+// Elements whose values live in a StringPool. Repeated values, such as the
+// title and release group of every episode of a series, cost an ID each.
+class InternedElements {
+public:
+  typedef std::pair<ElementCategory, string_id_t> value_type;
+  typedef std::vector<value_type>::const_iterator const_iterator;
+
+  InternedElements();
+
+  // If the pool is full, returns false and leaves no elements
+  bool assign(const Elements& elements, StringPool& pool);
+  void restore(const StringPool& pool, Elements& elements) const;
+
+  // Capacity
+  bool empty() const;
+  size_t size() const;
+
+  // Iterators
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Value access
+  ElementValueView get(ElementCategory category, const StringPool& pool) const;
+
+  size_t memory_usage() const;
+
+private:
+  std::vector<value_type> elements_;
+};
+
+}  // namespace anitomy
+
+#endif  // ANITOMY_STRING_POOL_H
\ No newline at end of file
@@ -37,13 +37,16 @@ TokenRange::TokenRange(size_t offset, size_t size)
 
 Token::Token()
     : category(kUnknown),
-      enclosed(false) {
+      enclosed(false),
+      offset(string_t::npos) {
 }
 
-Token::Token(TokenCategory category, const string_t& content, bool enclosed)
+Token::Token(TokenCategory category, const string_t& content, bool enclosed,
+             size_t offset)
     : category(category),
       content(content),
-      enclosed(enclosed) {
+      enclosed(enclosed),
+      offset(offset) {
 }
 
 bool Token::operator==(const Token& token) const {
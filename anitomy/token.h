@@ -64,13 +64,15 @@ public:
 class Token {
 public:
   Token();
-  Token(TokenCategory category, const string_t& content, bool enclosed);
+  Token(TokenCategory category, const string_t& content, bool enclosed,
+        size_t offset = string_t::npos);
 
   bool operator==(const Token& token) const;
 
   TokenCategory category;
   string_t content;
   bool enclosed;
+  size_t offset;  // Where content begins in the filename, npos if unknown
 };
 
 typedef std::vector<Token> token_container_t;
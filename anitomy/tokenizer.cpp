@@ -26,19 +26,20 @@
 namespace anitomy {
 
 Tokenizer::Tokenizer(const string_t& filename, Elements& elements,
-                     const Options& options, token_container_t& tokens)
+                     const Options& options, const KeywordManager& keywords,
+                     token_container_t& tokens, ParseStats* stats,
+                     WorkBudget* budget)
     : elements_(elements),
       filename_(filename),
       options_(options),
-      tokens_(tokens) {
+      keywords_(keywords),
+      tokens_(tokens),
+      stats_(stats),
+      budget_(budget) {
 }
 
 bool Tokenizer::Tokenize() {
-  tokens_.reserve(32);  // Usually there are no more than 20 tokens
-
-  TokenizeByBrackets();
-
-  return !tokens_.empty();
+  return Tokenize(RuntimeProfile(options_));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -47,145 +48,21 @@ void Tokenizer::AddToken(TokenCategory category, bool enclosed,
                          const TokenRange& range) {
   tokens_.push_back(Token(category,
                           filename_.substr(range.offset, range.size),
-                          enclosed));
+                          enclosed, range.offset));
 }
 
-  static /*const*/ std::vector<std::pair<char_t, char_t>> brackets;
-
-  // This is basically std::find_first_of() customized to our needs
-  string_t::const_iterator find_first_bracket(char_t &matching_bracket, string_t::const_iterator char_begin, const string_t::const_iterator char_end) {
-    for (string_t::const_iterator it = char_begin; it != char_end; ++it) {
-      for (std::vector<std::pair<char_t, char_t>>::const_iterator bracket_pair = brackets.begin(); bracket_pair != brackets.end(); ++bracket_pair) {
-        if (*it == bracket_pair->first) {
-          matching_bracket = bracket_pair->second;
-          return it;
-        }
-      }
-    }
-    return char_end;
-  };
-
-void Tokenizer::TokenizeByBrackets() {
-  {
-      brackets.push_back(std::make_pair<char_t, char_t>(L'(', L')'));  // U+0028-U+0029 Parenthesis
-      brackets.push_back(std::make_pair<char_t, char_t>(L'[', L']'));  // U+005B-U+005D Square bracket
-      brackets.push_back(std::make_pair<char_t, char_t>(L'{', L'}'));  // U+007B-U+007D Curly bracket
-      brackets.push_back(std::make_pair<char_t, char_t>(L'\u300C', L'\u300D'));  // Corner bracket
-      brackets.push_back(std::make_pair<char_t, char_t>(L'\u300E', L'\u300F'));  // White corner bracket
-      brackets.push_back(std::make_pair<char_t, char_t>(L'\u3010', L'\u3011'));  // Black lenticular bracket
-      brackets.push_back(std::make_pair<char_t, char_t>(L'\uFF08', L'\uFF09'));  // Fullwidth parenthesis
-  };
-
-  bool is_bracket_open = false;
-  char_t matching_bracket = L'\0';
-
-  string_t::const_iterator char_begin = filename_.begin();
-  const string_t::const_iterator char_end = filename_.end();
-
-  string_t::const_iterator current_char = char_begin;
-
-  while (current_char != char_end && char_begin != char_end) {
-    if (!is_bracket_open) {
-      current_char = find_first_bracket(matching_bracket, char_begin, char_end);
-    } else {
-      // Looking for the matching bracket allows us to better handle some rare
-      // cases with nested brackets.
-      current_char = std::find(char_begin, char_end, matching_bracket);
-    }
-
-    const TokenRange range(std::distance(filename_.begin(), char_begin),
-                           std::distance(char_begin, current_char));
-
-    if (range.size > 0)  // Found unknown token
-      TokenizeByPreidentified(is_bracket_open, range);
-
-    if (current_char != char_end) {  // Found bracket
-      AddToken(kBracket, true, TokenRange(range.offset + range.size, 1));
-      is_bracket_open = !is_bracket_open;
-      char_begin = ++current_char;
-    }
-  }
+bool Tokenizer::Spend(size_t steps) {
+  return !budget_ || budget_->Spend(steps);
 }
 
-void Tokenizer::TokenizeByPreidentified(bool enclosed, const TokenRange& range) {
-  std::vector<TokenRange> preidentified_tokens;
-  keyword_manager.Peek(filename_, range, elements_, preidentified_tokens);
-
-  size_t offset = range.offset;
-  TokenRange subrange(range.offset, 0);
-
-  while (offset < range.offset + range.size) {
-    for (std::vector<TokenRange>::const_iterator preidentified_token = preidentified_tokens.begin(); preidentified_token != preidentified_tokens.end(); ++preidentified_token) {
-      if (offset == preidentified_token->offset) {
-        if (subrange.size > 0)
-          TokenizeByDelimiters(enclosed, subrange);
-        AddToken(kIdentifier, enclosed, *preidentified_token);
-        subrange.offset = preidentified_token->offset + preidentified_token->size;
-        offset = subrange.offset - 1;  // It's going to be incremented below
-        break;
-      }
-    }
-    subrange.size = ++offset - subrange.offset;
-  }
-
-  // Either there was no preidentified token range, or we're now about to
-  // process the tail of our current range.
-  if (subrange.size > 0)
-    TokenizeByDelimiters(enclosed, subrange);
-}
-
-void Tokenizer::TokenizeByDelimiters(bool enclosed, const TokenRange& range) {
-  const string_t delimiters = GetDelimiters(range);
-
-  if (delimiters.empty()) {
-    AddToken(kUnknown, enclosed, range);
-    return;
-  }
-
-  string_t::const_iterator char_begin = filename_.begin() + range.offset;
-  const string_t::const_iterator char_end = char_begin + range.size;
-  string_t::const_iterator current_char = char_begin;
-
-  while (current_char != char_end) {
-    current_char = std::find_first_of(current_char, char_end,
-                                      delimiters.begin(), delimiters.end());
-
-    const TokenRange subrange(std::distance(filename_.begin(), char_begin),
-                              std::distance(char_begin, current_char));
-
-    if (subrange.size > 0)  // Found unknown token
-      AddToken(kUnknown, enclosed, subrange);
-
-    if (current_char != char_end) {  // Found delimiter
-      AddToken(kDelimiter, enclosed,
-               TokenRange(subrange.offset + subrange.size, 1));
-      char_begin = ++current_char;
-    }
-  }
-
-  ValidateDelimiterTokens();
+void Tokenizer::Peek(const TokenRange& range,
+                     std::vector<TokenRange>& preidentified_tokens) {
+  ANITOMY_TIME_STAGE(stats_, kParseStagePeek);
+  keywords_.Peek(filename_, range, elements_, preidentified_tokens);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool is_delimiter(const char_t c, const Tokenizer *tokenizer) {
-	if (!IsAlphanumericChar(c))
-		if (tokenizer->options_.allowed_delimiters.find(c) != string_t::npos)
-			if (tokenizer->delimiters.find(c) == string_t::npos)
-				return true;
-	return false;
-};
-
-string_t Tokenizer::GetDelimiters(const TokenRange& range) const {
-  delimiters.clear();
-
-  std::remove_copy_if(filename_.begin() + range.offset,
-               filename_.begin() + range.offset + range.size,
-               std::back_inserter(delimiters), std::not1(std::bind2nd(std::ptr_fun(is_delimiter), this)));
-
-  return delimiters;
-}
-
 bool is_delimiter_token(token_container_t& tokens_, token_iterator_t it) {
 	return it != tokens_.end() && it->category == kDelimiter;
 };
@@ -205,6 +82,9 @@ bool is_invalid_token(const Token& token) {
 }
 
 void Tokenizer::ValidateDelimiterTokens() {
+  if (!Spend(tokens_.size()))
+    return;
+
   for (token_iterator_t token = tokens_.begin(); token != tokens_.end(); ++token) {
     if (token->category != kDelimiter)
       continue;
@@ -19,8 +19,16 @@
 #ifndef ANITOMY_TOKENIZER_H
 #define ANITOMY_TOKENIZER_H
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "budget.h"
 #include "element.h"
+#include "keyword.h"
 #include "options.h"
+#include "profile.h"
+#include "stats.h"
 #include "string.h"
 #include "token.h"
 
@@ -29,29 +37,185 @@ namespace anitomy {
 class Tokenizer {
 public:
   Tokenizer(const string_t& filename, Elements& elements,
-            const Options& options, token_container_t& tokens);
+            const Options& options, const KeywordManager& keywords,
+            token_container_t& tokens, ParseStats* stats = NULL,
+            WorkBudget* budget = NULL);
 
   Tokenizer(const Tokenizer&);// = delete;
   Tokenizer& operator=(const Tokenizer&);// = delete;
 
   bool Tokenize();
 
-  const Options& options_;
-  mutable string_t delimiters;
+  // See profile.h
+  template <class Profile>
+  bool Tokenize(const Profile& profile);
+
 private:
   void AddToken(TokenCategory category, bool enclosed, const TokenRange& range);
-  void TokenizeByBrackets();
-  void TokenizeByPreidentified(bool enclosed, const TokenRange& range);
-  void TokenizeByDelimiters(bool enclosed, const TokenRange& range);
+  bool Spend(size_t steps);
+  void Peek(const TokenRange& range,
+            std::vector<TokenRange>& preidentified_tokens);
+
+  template <class Profile>
+  void TokenizeByBrackets(const Profile& profile);
+  template <class Profile>
+  void TokenizeByPreidentified(const Profile& profile, bool enclosed,
+                               const TokenRange& range);
+  template <class Profile>
+  void TokenizeByDelimiters(const Profile& profile, bool enclosed,
+                            const TokenRange& range);
 
-  string_t GetDelimiters(const TokenRange& range) const;
+  template <class Profile>
+  string_t GetDelimiters(const Profile& profile,
+                         const TokenRange& range) const;
   void ValidateDelimiterTokens();
 
   Elements& elements_;
   const string_t& filename_;
+  const Options& options_;
+  const KeywordManager& keywords_;
   token_container_t& tokens_;
+  ParseStats* stats_;
+  WorkBudget* budget_;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+
+template <class Profile>
+bool Tokenizer::Tokenize(const Profile& profile) {
+  ANITOMY_TIME_STAGE(stats_, kParseStageTokenize);
+
+  tokens_.reserve(32);  // Usually there are no more than 20 tokens
+
+  TokenizeByBrackets(profile);
+
+  return !tokens_.empty();
+}
+
+template <class Profile>
+void Tokenizer::TokenizeByBrackets(const Profile& profile) {
+  bool is_bracket_open = false;
+  char_t matching_bracket = L'\0';
+
+  string_t::const_iterator char_begin = filename_.begin();
+  const string_t::const_iterator char_end = filename_.end();
+
+  string_t::const_iterator current_char = char_begin;
+
+  while (current_char != char_end && char_begin != char_end) {
+    if (!Spend(1))
+      return;
+    if (!is_bracket_open) {
+      // This is basically std::find_first_of() customized to our needs
+      for (current_char = char_begin; current_char != char_end;
+           ++current_char) {
+        matching_bracket = profile.GetMatchingBracket(*current_char);
+        if (matching_bracket != L'\0')
+          break;
+      }
+    } else {
+      // Looking for the matching bracket allows us to better handle some rare
+      // cases with nested brackets.
+      current_char = std::find(char_begin, char_end, matching_bracket);
+    }
+
+    const TokenRange range(std::distance(filename_.begin(), char_begin),
+                           std::distance(char_begin, current_char));
+
+    if (range.size > 0)  // Found unknown token
+      TokenizeByPreidentified(profile, is_bracket_open, range);
+
+    if (current_char != char_end) {  // Found bracket
+      AddToken(kBracket, true, TokenRange(range.offset + range.size, 1));
+      is_bracket_open = !is_bracket_open;
+      char_begin = ++current_char;
+    }
+  }
+}
+
+template <class Profile>
+void Tokenizer::TokenizeByPreidentified(const Profile& profile, bool enclosed,
+                                        const TokenRange& range) {
+  std::vector<TokenRange> preidentified_tokens;
+  Peek(range, preidentified_tokens);
+
+  size_t offset = range.offset;
+  TokenRange subrange(range.offset, 0);
+
+  while (offset < range.offset + range.size) {
+    for (std::vector<TokenRange>::const_iterator preidentified_token = preidentified_tokens.begin(); preidentified_token != preidentified_tokens.end(); ++preidentified_token) {
+      if (offset == preidentified_token->offset) {
+        if (subrange.size > 0)
+          TokenizeByDelimiters(profile, enclosed, subrange);
+        AddToken(kIdentifier, enclosed, *preidentified_token);
+        subrange.offset = preidentified_token->offset + preidentified_token->size;
+        offset = subrange.offset - 1;  // It's going to be incremented below
+        break;
+      }
+    }
+    subrange.size = ++offset - subrange.offset;
+  }
+
+  // Either there was no preidentified token range, or we're now about to
+  // process the tail of our current range.
+  if (subrange.size > 0)
+    TokenizeByDelimiters(profile, enclosed, subrange);
+}
+
+template <class Profile>
+void Tokenizer::TokenizeByDelimiters(const Profile& profile, bool enclosed,
+                                     const TokenRange& range) {
+  const string_t delimiters = GetDelimiters(profile, range);
+
+  if (delimiters.empty()) {
+    AddToken(kUnknown, enclosed, range);
+    return;
+  }
+
+  string_t::const_iterator char_begin = filename_.begin() + range.offset;
+  const string_t::const_iterator char_end = char_begin + range.size;
+  string_t::const_iterator current_char = char_begin;
+
+  while (current_char != char_end) {
+    if (!Spend(1))
+      return;
+    current_char = std::find_first_of(current_char, char_end,
+                                      delimiters.begin(), delimiters.end());
+
+    const TokenRange subrange(std::distance(filename_.begin(), char_begin),
+                              std::distance(char_begin, current_char));
+
+    if (subrange.size > 0)  // Found unknown token
+      AddToken(kUnknown, enclosed, subrange);
+
+    if (current_char != char_end) {  // Found delimiter
+      AddToken(kDelimiter, enclosed,
+               TokenRange(subrange.offset + subrange.size, 1));
+      char_begin = ++current_char;
+    }
+  }
+
+  ValidateDelimiterTokens();
+}
+
+// Returns the delimiters found in the range, each only once
+template <class Profile>
+string_t Tokenizer::GetDelimiters(const Profile& profile,
+                                  const TokenRange& range) const {
+  string_t delimiters;
+
+  const string_t::const_iterator char_end =
+      filename_.begin() + range.offset + range.size;
+  for (string_t::const_iterator it = filename_.begin() + range.offset;
+       it != char_end; ++it) {
+    if (profile.IsDelimiter(*it) && !IsAlphanumericChar(*it) &&
+        delimiters.find(*it) == string_t::npos)
+      delimiters.push_back(*it);
+  }
+
+  return delimiters;
+}
+
 }  // namespace anitomy
 
 #endif  // ANITOMY_TOKENIZER_H
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Parses every entry in test/data.json under a range of work budgets, and
+// checks the contract of Options::max_work and max_nanoseconds: a parse that
+// runs out of its budget returns false and sets budget_exceeded(), there is a
+// single threshold below which every budget runs out, and a budget that is
+// large enough changes nothing. This holds with every category requested,
+// and with only a few, where the parser stops after an earlier stage.
+
+#include "../anitomy/anitomy.h"
+#include "../tools/common/test_runner.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+static const size_t kBudgets[] = {
+  1, 2, 5, 10, 20, 50, 100, 101, 150, 200, 300, 500, 1000, 5000
+};
+
+static bool IsSame(const Elements& a, const Elements& b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); ++i)
+    if (a[i] != b[i])
+      return false;
+  return true;
+}
+
+static void CheckBudgets(const std::string& filename, Anitomy& anitomy,
+                         element_category_mask_t categories) {
+  const string_t input = Utf8ToString(filename);
+  anitomy.options().max_work = 0;
+  anitomy.options().requested_categories = categories;
+
+  const bool expected_result = anitomy.Parse(input);
+  const Elements expected = anitomy.elements();
+  if (anitomy.budget_exceeded())
+    Fail(filename, "budget exceeded without a limit");
+
+  bool exceeded_before = true;
+  for (size_t i = 0; i < sizeof(kBudgets) / sizeof(kBudgets[0]); ++i) {
+    anitomy.options().max_work = kBudgets[i];
+    const bool result = anitomy.Parse(input);
+    const bool exceeded = anitomy.budget_exceeded();
+    if (result && exceeded)
+      Fail(filename, "parse succeeded with an exhausted budget");
+    if (exceeded && !exceeded_before)
+      Fail(filename, "a larger budget ran out where a smaller one did not");
+    if (!exceeded &&
+        (result != expected_result || !IsSame(anitomy.elements(), expected)))
+      Fail(filename, "a sufficient budget changed the result");
+    exceeded_before = exceeded;
+  }
+
+  anitomy.options().max_work = 1;
+  if (anitomy.Parse(input) || !anitomy.budget_exceeded())
+    Fail(filename, "a budget of one step was not exceeded");
+
+  anitomy.options().max_work = 1000000;
+  if (anitomy.Parse(input) != expected_result || anitomy.budget_exceeded() ||
+      !IsSame(anitomy.elements(), expected))
+    Fail(filename, "a large budget changed the result");
+}
+
+static void CheckEntry(const std::string& filename, Anitomy& anitomy) {
+  CheckBudgets(filename, anitomy, kElementCategoryMaskAll);
+  CheckBudgets(filename, anitomy, ElementCategoryMask(kElementFileChecksum));
+  CheckBudgets(filename, anitomy, ElementCategoryMask(kElementEpisodeNumber));
+  CheckBudgets(filename, anitomy, ElementCategoryMask(kElementAnimeTitle) |
+                                  ElementCategoryMask(kElementReleaseGroup));
+}
+
+// The deadline is only checked every so many steps, so it needs a filename
+// with many tokens
+static void CheckDeadline() {
+  string_t input = L"[Group] Title";
+  for (int i = 0; i < 500; ++i)
+    input += L" [Tag]";
+  input += L" - 01.mkv";
+
+  Anitomy anitomy;
+  anitomy.options().max_nanoseconds = 1;
+  if (anitomy.Parse(input) || !anitomy.budget_exceeded())
+    Fail("deadline", "a deadline of one nanosecond was not exceeded");
+
+  anitomy.options().max_nanoseconds = 60ULL * 1000000000ULL;
+  if (!anitomy.Parse(input) || anitomy.budget_exceeded())
+    Fail("deadline", "a deadline of one minute was exceeded");
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<TestEntry> entries;
+  if (!LoadTestEntries(argc, argv, entries))
+    return 1;
+
+  CheckDeadline();
+
+  Anitomy anitomy;
+  ForEachTestEntry(entries, anitomy, CheckEntry);
+
+  return ReportTestResults(entries.size());
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Parses every entry in test/data.json through the C interface, one at a
+// time and in small batches, and checks that the elements are the same as
+// those of Anitomy::Parse, in UTF-8.
+
+#include <cstring>
+
+#include "../anitomy/anitomy.h"
+#include "../anitomy/c_api.h"
+#include "../tools/common/test_runner.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+static bool IsSame(const Elements& expected, const anitomy_element* elements,
+                   size_t count, const char* arena) {
+  if (count != expected.size())
+    return false;
+  for (size_t i = 0; i < count; ++i) {
+    const std::string value = StringToUtf8(expected[i].second);
+    if (elements[i].category != expected[i].first ||
+        elements[i].length != value.size() ||
+        std::memcmp(arena + elements[i].offset, value.data(),
+                    value.size()) != 0)
+      return false;
+  }
+  return true;
+}
+
+// Results of Anitomy::Parse, for the entries that the C interface can parse
+// the same way. It has no options other than categories.
+struct CollectExpected {
+  void operator()(const std::string& filename, Anitomy& anitomy) {
+    if (!anitomy.options().ignored_strings.empty() ||
+        anitomy.options().allowed_delimiters != Options().allowed_delimiters)
+      return;
+    filenames.push_back(filename);
+    results.push_back(anitomy.Parse(Utf8ToString(filename)));
+    elements.push_back(anitomy.elements());
+  }
+
+  std::vector<std::string> filenames;
+  std::vector<bool> results;
+  std::vector<Elements> elements;
+};
+
+int main(int argc, char* argv[]) {
+  std::vector<TestEntry> entries;
+  if (!LoadTestEntries(argc, argv, entries))
+    return 1;
+
+  Anitomy anitomy;
+  CollectExpected collected;
+  ForEachTestEntry(entries, anitomy, collected);
+  const std::vector<std::string>& filenames = collected.filenames;
+  const std::vector<Elements>& expected = collected.elements;
+  const std::vector<bool>& expected_results = collected.results;
+
+  anitomy_parser* parser = anitomy_create();
+  anitomy_element elements[64];
+  char arena[1024];
+
+  for (size_t i = 0; i < filenames.size(); ++i) {
+    size_t element_count = 0;
+    size_t arena_used = 0;
+    const int status = anitomy_parse_utf8(
+        parser, filenames[i].data(), filenames[i].size(), elements, 64,
+        &element_count, arena, sizeof(arena), &arena_used);
+    if (status != (expected_results[i] ? ANITOMY_OK : ANITOMY_NOT_PARSED) ||
+        !IsSame(expected[i], elements, element_count, arena))
+      Fail(filenames[i], "differs from Anitomy::Parse");
+
+    // Too small by one byte, then by one element
+    if (anitomy_parse_utf8(parser, filenames[i].data(), filenames[i].size(),
+                           elements, 64, &element_count, arena,
+                           arena_used - 1, &arena_used) !=
+            ANITOMY_BUFFER_TOO_SMALL ||
+        anitomy_parse_utf8(parser, filenames[i].data(), filenames[i].size(),
+                           elements, element_count - 1, &element_count,
+                           arena, sizeof(arena), &arena_used) !=
+            ANITOMY_BUFFER_TOO_SMALL)
+      Fail(filenames[i], "small buffers are not reported");
+  }
+
+  // Batches that stop whenever the buffers are full
+  std::vector<const char*> data;
+  std::vector<size_t> lengths;
+  for (size_t i = 0; i < filenames.size(); ++i) {
+    data.push_back(filenames[i].data());
+    lengths.push_back(filenames[i].size());
+  }
+  std::vector<anitomy_result> results(filenames.size());
+  for (size_t first = 0; first < filenames.size();) {
+    size_t arena_used = 0;
+    const size_t count = anitomy_parse_batch_utf8(
+        parser, &data[first], &lengths[first], filenames.size() - first,
+        &results[first], elements, 64, arena, sizeof(arena), &arena_used);
+    if (count == 0) {
+      Fail(filenames[first], "does not fit in a batch");
+      break;
+    }
+    for (size_t i = first; i < first + count; ++i) {
+      if (results[i].status !=
+              (expected_results[i] ? ANITOMY_OK : ANITOMY_NOT_PARSED) ||
+          !IsSame(expected[i], elements + results[i].first_element,
+                  results[i].element_count, arena))
+        Fail(filenames[i], "differs in a batch");
+    }
+    first += count;
+  }
+
+  // A NULL filename with a length fails on its own, not the whole batch
+  if (!filenames.empty()) {
+    const char* invalid_data[] = {data[0], NULL, data[0]};
+    const size_t invalid_lengths[] = {lengths[0], 1, lengths[0]};
+    anitomy_result invalid_results[3];
+    size_t arena_used = 0;
+    if (anitomy_parse_batch_utf8(parser, invalid_data, invalid_lengths, 3,
+                                 invalid_results, elements, 64, arena,
+                                 sizeof(arena), &arena_used) != 3 ||
+        invalid_results[1].status != ANITOMY_ERROR ||
+        invalid_results[1].element_count != 0 ||
+        invalid_results[2].status != results[0].status ||
+        invalid_results[2].element_count != expected[0].size())
+      Fail("batch", "a NULL filename is not reported on its own");
+  }
+  anitomy_set_requested_categories(NULL, kElementCategoryMaskAll);
+
+  anitomy_destroy(parser);
+
+  return ReportTestResults(filenames.size());
+}
\ No newline at end of file
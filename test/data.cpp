@@ -0,0 +1,188 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// Parses every entry in test/data.json, compares each field with the
+// expected values, and reports pass rates per field along with the time the
+// parses took, so that changes can be checked for accuracy and speed at once.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../anitomy/anitomy.h"
+#include "../tools/common/element_name.h"
+#include "../tools/common/test_data.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+struct FieldResult {
+  FieldResult() : checked(0), passed(0) {}
+
+  size_t checked;
+  size_t passed;
+};
+
+static std::string JoinValues(const std::vector<std::string>& values) {
+  std::string result;
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (i > 0)
+      result += " | ";
+    result += "\"" + values[i] + "\"";
+  }
+  return values.empty() ? "(none)" : result;
+}
+
+static int PrintUsage() {
+  std::fprintf(stderr,
+      "Usage: test_data [data.json] [--iterations n] [--max-failures n]\n"
+      "                 [--max-ns n] [--quiet]\n");
+  return 1;
+}
+
+int main(int argc, char* argv[]) {
+  std::string path = "test/data.json";
+  size_t iterations = 100;
+  // The number of entries that fail at the time of writing; lower it as the
+  // parser improves
+  size_t max_failures = 34;
+  double max_ns = 0;
+  bool quiet = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && std::strcmp(argv[i], "--iterations") == 0) {
+      iterations = std::strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--max-failures") == 0) {
+      max_failures = std::strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--max-ns") == 0) {
+      max_ns = std::strtod(argv[++i], NULL);
+    } else if (std::strcmp(argv[i], "--quiet") == 0) {
+      quiet = true;
+    } else if (argv[i][0] != '-') {
+      path = argv[i];
+    } else {
+      return PrintUsage();
+    }
+  }
+
+  std::vector<TestEntry> entries;
+  if (!LoadTestData(path, entries)) {
+    std::printf("Cannot read %s\n", path.c_str());
+    return 1;
+  }
+
+  Anitomy anitomy;
+  FieldResult fields[kElementIterateLast];
+  size_t failures = 0;
+  unsigned long long elapsed = 0;
+
+  for (std::vector<TestEntry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry) {
+    const std::string filename = entry->get("file_name");
+    const string_t input = Utf8ToString(filename);
+    ApplyTestOptions(*entry, anitomy.options());
+
+    const unsigned long long start = GetStatsClock();
+    anitomy.Parse(input);
+    elapsed += GetStatsClock() - start;
+
+    bool failed = false;
+    for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+      const ElementCategory category = static_cast<ElementCategory>(i);
+      if (category == kElementFileName)
+        continue;
+
+      std::vector<std::string> expected;
+      TestEntry::field_container_t::const_iterator it =
+          entry->fields.find(ElementCategoryName(category));
+      if (it != entry->fields.end())
+        expected = it->second;
+
+      std::vector<std::string> actual;
+      const std::vector<string_t> values = anitomy.elements().get_all(category);
+      for (size_t j = 0; j < values.size(); ++j)
+        actual.push_back(StringToUtf8(values[j]));
+
+      // Fields that are neither expected nor found aren't counted
+      if (expected.empty() && actual.empty())
+        continue;
+      ++fields[category].checked;
+      if (expected == actual) {
+        ++fields[category].passed;
+        continue;
+      }
+
+      if (!quiet) {
+        if (!failed)
+          std::printf("FAIL: %s\n", filename.c_str());
+        std::printf("      %s: expected %s, got %s\n",
+                    ElementCategoryName(category),
+                    JoinValues(expected).c_str(), JoinValues(actual).c_str());
+      }
+      failed = true;
+    }
+    if (failed)
+      ++failures;
+  }
+
+  // The checked run parses each entry once, which is too short to time
+  // reliably; these passes only measure
+  unsigned long long timed = 0;
+  if (iterations) {
+    const unsigned long long start = GetStatsClock();
+    for (size_t iteration = 0; iteration < iterations; ++iteration) {
+      for (std::vector<TestEntry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry) {
+        ApplyTestOptions(*entry, anitomy.options());
+        anitomy.Parse(Utf8ToString(entry->get("file_name")));
+      }
+    }
+    timed = GetStatsClock() - start;
+  }
+
+  std::printf("\n%-22s %8s %8s %8s\n", "field", "checked", "passed", "rate");
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+    const FieldResult& field = fields[i];
+    if (!field.checked)
+      continue;
+    std::printf("%-22s %8lu %8lu %7.1f%%\n",
+                ElementCategoryName(static_cast<ElementCategory>(i)),
+                static_cast<unsigned long>(field.checked),
+                static_cast<unsigned long>(field.passed),
+                field.passed * 100.0 / field.checked);
+  }
+
+  const double ns_per_parse = iterations ?
+      timed / static_cast<double>(entries.size() * iterations) :
+      elapsed / static_cast<double>(entries.size());
+  std::printf("\n%lu entries, %lu failed\n",
+              static_cast<unsigned long>(entries.size()),
+              static_cast<unsigned long>(failures));
+  std::printf("%.1f ns/parse (checked run: %.1f ns/parse)\n",
+              ns_per_parse, elapsed / static_cast<double>(entries.size()));
+
+  if (failures > max_failures) {
+    std::printf("More than %lu failures\n",
+                static_cast<unsigned long>(max_failures));
+    return 1;
+  }
+  if (max_ns > 0 && ns_per_parse > max_ns) {
+    std::printf("Slower than %.1f ns/parse\n", max_ns);
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Stores the parse results of test/data.json in an ElementTable, checks every
+// row and column against the original elements, round-trips the table through
+// a file, makes sure that damaged files are refused, and compares its memory
+// usage to that of Elements objects.
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "../anitomy/anitomy.h"
+#include "../anitomy/element_table.h"
+#include "../tools/common/test_runner.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+static void FailRow(size_t row, const char* message) {
+  char name[32];
+  std::sprintf(name, "row %lu", static_cast<unsigned long>(row));
+  Fail(name, message);
+}
+
+static void CheckTable(const ElementTable& table,
+                       const std::vector<Elements>& results) {
+  if (table.rows() != results.size()) {
+    Fail("table", "row count differs");
+    return;
+  }
+
+  for (size_t row = 0; row < results.size(); ++row) {
+    const Elements& elements = results[row];
+    const Elements stored = table.row(row);
+    for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+      const ElementCategory category = static_cast<ElementCategory>(i);
+      const std::vector<string_t> values = elements.get_all(category);
+      if (stored.get_all(category) != values ||
+          table.count(row, category) != values.size() ||
+          table.column(category).is_valid(row) != !values.empty() ||
+          (!values.empty() &&
+           table.get(row, category).str() != StringToUtf8(values.front()))) {
+        FailRow(row, "stored values differ");
+        break;
+      }
+    }
+  }
+
+  // A column scan sees the values of every row, in order
+  const ElementColumn& column = table.column(kElementEpisodeNumber);
+  size_t index = 0;
+  for (size_t row = 0; row < results.size(); ++row) {
+    const std::vector<string_t> values =
+        results[row].get_all(kElementEpisodeNumber);
+    for (size_t i = 0; i < values.size(); ++i, ++index) {
+      if (index >= column.value_count() ||
+          column.value(index).str() != StringToUtf8(values[i])) {
+        FailRow(row, "column scan differs");
+        return;
+      }
+    }
+  }
+  if (index != column.value_count())
+    Fail("table", "column scan has extra values");
+}
+
+static void SetUint32(std::string& data, size_t position, unsigned int value) {
+  for (size_t i = 0; i < 4; ++i)
+    data[position + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+// Each damaged copy of an exported file must fail to import, and leave the
+// table empty
+static void CheckDamagedImports(const std::string& table_path) {
+  std::string data;
+  {
+    std::ifstream file(table_path.c_str(), std::ios::in | std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+  }
+
+  // Positions in the file header, and in the header of the first column
+  const size_t rows = 8;
+  const size_t value_count = 20;
+  const size_t arena_size = 24;
+  const size_t validity = 28;
+
+  std::vector<std::string> damaged(5, data);
+  SetUint32(damaged[0], rows, 0xFFFFFFFF);
+  SetUint32(damaged[1], rows, 0x10000000);
+  SetUint32(damaged[2], value_count, 0x40000000);
+  SetUint32(damaged[3], arena_size, 0xFFFFFFF0);
+  damaged[4][validity] ^= 1;
+  damaged.push_back(data.substr(0, data.size() - 1));
+
+  for (size_t i = 0; i < damaged.size(); ++i) {
+    {
+      std::ofstream file(table_path.c_str(), std::ios::out | std::ios::binary);
+      file.write(damaged[i].data(), damaged[i].size());
+    }
+    ElementTable table;
+    if (table.Import(table_path) || !table.empty()) {
+      char name[32];
+      std::sprintf(name, "damaged file %lu", static_cast<unsigned long>(i));
+      Fail(name, "was imported");
+    }
+  }
+}
+
+struct AppendResults {
+  void operator()(const std::string& filename, Anitomy& anitomy) {
+    anitomy.Parse(Utf8ToString(filename));
+    if (!table.Append(anitomy.elements()))
+      Fail(filename, "Append failed");
+    results.push_back(anitomy.elements());
+  }
+
+  ElementTable table;
+  std::vector<Elements> results;
+};
+
+int main(int argc, char* argv[]) {
+  const std::string table_path = argc > 2 ? argv[2] : "element_table.antb";
+
+  std::vector<TestEntry> entries;
+  if (!LoadTestEntries(argc, argv, entries))
+    return 1;
+
+  Anitomy anitomy;
+  AppendResults appended;
+  ForEachTestEntry(entries, anitomy, appended);
+  const ElementTable& table = appended.table;
+  const std::vector<Elements>& results = appended.results;
+
+  CheckTable(table, results);
+
+  if (!table.Export(table_path)) {
+    std::printf("Cannot write %s\n", table_path.c_str());
+    return 1;
+  }
+  ElementTable imported;
+  if (!imported.Import(table_path)) {
+    Fail(table_path, "Import failed");
+  } else {
+    CheckTable(imported, results);
+  }
+  CheckDamagedImports(table_path);
+  std::remove(table_path.c_str());
+
+  // Memory is compared on a larger batch, where fixed costs don't matter
+  const size_t repeat = 1000;
+  ElementTable batch;
+  size_t elements_size = 0;
+  for (size_t i = 0; i < repeat; ++i) {
+    for (size_t row = 0; row < results.size(); ++row) {
+      batch.Append(results[row]);
+      elements_size += results[row].memory_usage();
+    }
+  }
+  std::printf("%lu rows, %.1f bytes per row in a table, at least %.1f bytes "
+              "per row as Elements\n",
+              static_cast<unsigned long>(batch.rows()),
+              batch.memory_usage() / static_cast<double>(batch.rows()),
+              elements_size / static_cast<double>(batch.rows()));
+
+  return ReportTestResults(entries.size());
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Parses every entry in test/data.json with two Anitomy objects: one with the
+// default keyword set, and one with a KeywordManager of its own that has a
+// keyword added. They must agree on every entry, and only the second one
+// may find the added keyword.
+
+#include <algorithm>
+
+#include "../anitomy/anitomy.h"
+#include "../tools/common/test_runner.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+static bool HasElement(Anitomy& anitomy, ElementCategory category,
+                       const string_t& value) {
+  const std::vector<string_t> values = anitomy.elements().get_all(category);
+  return std::find(values.begin(), values.end(), value) != values.end();
+}
+
+static const std::string added = "[Group] Some Title - 01 [WEB-DL 1080p].mkv";
+
+// Parses with the default keywords through the Anitomy it is given, and with
+// its own keywords through `custom`
+struct CheckKeywords {
+  explicit CheckKeywords(const KeywordManager& keywords) {
+    custom.set_keywords(keywords);
+  }
+
+  void operator()(const std::string& filename, Anitomy& anitomy);
+
+  Anitomy custom;
+};
+
+void CheckKeywords::operator()(const std::string& filename, Anitomy& anitomy) {
+  custom.options() = anitomy.options();
+
+  anitomy.Parse(Utf8ToString(filename));
+  custom.Parse(Utf8ToString(filename));
+  const Elements& expected = anitomy.elements();
+  const Elements& actual = custom.elements();
+  bool same = expected.size() == actual.size();
+  for (size_t i = 0; same && i < expected.size(); ++i)
+    same = expected[i] == actual[i];
+  if (!same)
+    Fail(filename, "results differ between the keyword sets");
+
+  // In between, so that one parse can't leave anything for the next
+  custom.Parse(Utf8ToString(added));
+  if (!HasElement(custom, kElementSource, L"WEB-DL"))
+    Fail(added, "added keyword was not found");
+  anitomy.Parse(Utf8ToString(added));
+  if (HasElement(anitomy, kElementSource, L"WEB-DL"))
+    Fail(added, "added keyword leaked into the default keyword set");
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<TestEntry> entries;
+  if (!LoadTestEntries(argc, argv, entries))
+    return 1;
+
+  KeywordManager keywords;
+  std::vector<string_t> sources;
+  sources.push_back(L"WEB-DL");
+  keywords.Add(kElementSource, KeywordOptions(), sources);
+
+  Anitomy anitomy;
+  CheckKeywords check(keywords);
+  ForEachTestEntry(entries, anitomy, check);
+
+  std::vector<string_t> found;
+  keyword_manager.GetKeywords(kElementSource, found);
+  if (std::find(found.begin(), found.end(), L"WEB-DL") != found.end())
+    Fail(added, "keyword_manager was changed");
+
+  return ReportTestResults(entries.size());
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Round-trips the parse results of every entry in test/data.json through the
+// binary encoding, with and without dictionaries, and checks that the
+// zero-copy view agrees with the original elements.
+
+#include <cstdio>
+
+#include "../anitomy/anitomy.h"
+#include "../anitomy/serialization.h"
+#include "../tools/common/test_runner.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+static void CheckRoundTrip(const std::string& filename, Elements& elements,
+                           const ElementDictionary* dictionary,
+                           size_t& total_size) {
+  std::string data;
+  SerializeElements(elements, data, dictionary);
+  total_size += data.size();
+
+  Elements result;
+  if (!DeserializeElements(data.data(), data.size(), result, dictionary)) {
+    Fail(filename, "DeserializeElements failed");
+    return;
+  }
+  if (result.size() != elements.size()) {
+    Fail(filename, "element count differs");
+    return;
+  }
+  for (size_t i = 0; i < elements.size(); ++i) {
+    if (result[i] != elements[i]) {
+      Fail(filename, "element differs after round trip");
+      return;
+    }
+  }
+
+  ElementsView view(data.data(), data.size(), dictionary);
+  if (!view.valid() || view.size() != elements.size()) {
+    Fail(filename, "view is invalid");
+    return;
+  }
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+    const ElementCategory category = static_cast<ElementCategory>(i);
+    if (view.get(category).str() != StringToUtf8(elements.get(category)) ||
+        view.count(category) != elements.count(category) ||
+        view.empty(category) != elements.empty(category)) {
+      Fail(filename, "view disagrees with elements");
+      return;
+    }
+    const std::vector<ElementValueView> values = view.get_all(category);
+    const std::vector<string_t> expected = elements.get_all(category);
+    for (size_t j = 0; j < values.size(); ++j) {
+      if (values[j].str() != StringToUtf8(expected.at(j))) {
+        Fail(filename, "view disagrees with elements");
+        return;
+      }
+    }
+  }
+
+  // Truncated records must be rejected without reading out of bounds
+  for (size_t size = 0; size < data.size(); ++size) {
+    std::vector<char> truncated(data.begin(), data.begin() + size);
+    if (DeserializeElements(truncated.empty() ? NULL : &truncated[0], size,
+                            result, dictionary)) {
+      Fail(filename, "truncated record was accepted");
+      return;
+    }
+  }
+}
+
+// Round-trips each result without a dictionary, with the default one, and
+// with a user dictionary that extends the default one with release groups
+struct CheckEncodings {
+  CheckEncodings() : plain_size(0), dictionary_size(0), group_size(0) {
+    for (size_t i = 0; i < ElementDictionary::Default().size(); ++i)
+      groups.Add(*ElementDictionary::Default().Get(i));
+  }
+
+  void operator()(const std::string& filename, Anitomy& anitomy) {
+    anitomy.Parse(Utf8ToString(filename));
+
+    const string_t group = anitomy.elements().get(kElementReleaseGroup);
+    if (!group.empty())
+      groups.Add(StringToUtf8(group));
+
+    CheckRoundTrip(filename, anitomy.elements(), NULL, plain_size);
+    CheckRoundTrip(filename, anitomy.elements(), &ElementDictionary::Default(),
+                   dictionary_size);
+    CheckRoundTrip(filename, anitomy.elements(), &groups, group_size);
+  }
+
+  ElementDictionary groups;
+  size_t plain_size;
+  size_t dictionary_size;
+  size_t group_size;
+};
+
+int main(int argc, char* argv[]) {
+  std::vector<TestEntry> entries;
+  if (!LoadTestEntries(argc, argv, entries))
+    return 1;
+
+  Anitomy anitomy;
+  CheckEncodings check;
+  ForEachTestEntry(entries, anitomy, check);
+
+  std::printf("%lu records, average size: %.1f bytes, %.1f bytes with the "
+              "default dictionary, %.1f bytes with release groups\n",
+              static_cast<unsigned long>(entries.size()),
+              check.plain_size / static_cast<double>(entries.size()),
+              check.dictionary_size / static_cast<double>(entries.size()),
+              check.group_size / static_cast<double>(entries.size()));
+
+  return ReportTestResults(entries.size());
+}
\ No newline at end of file
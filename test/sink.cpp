@@ -0,0 +1,93 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Parses every entry in test/data.json into a sink, with every category and
+// with only a few, and checks that the sink receives the same elements, in
+// the same order, as a parse into Elements.
+
+#include "../anitomy/anitomy.h"
+#include "../tools/common/test_runner.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+class CollectingSink : public ElementSink {
+public:
+  void OnElement(ElementCategory category, const char_t* value,
+                 size_t length) {
+    elements.push_back(std::make_pair(category, string_t(value, length)));
+  }
+
+  element_container_t elements;
+};
+
+static void CheckSink(const std::string& filename, Anitomy& anitomy,
+                      element_category_mask_t categories) {
+  anitomy.options().requested_categories = categories;
+
+  const string_t input = Utf8ToString(filename);
+  const bool expected_result = anitomy.Parse(input);
+  const Elements expected = anitomy.elements();
+
+  CollectingSink sink;
+  const bool result = anitomy.ParseInto(input, sink);
+
+  bool same = result == expected_result &&
+              sink.elements.size() == expected.size() &&
+              anitomy.elements().empty();
+  for (size_t i = 0; same && i < expected.size(); ++i)
+    same = sink.elements[i] == expected[i];
+  if (!same)
+    Fail(filename, "sink disagrees with elements");
+}
+
+static void CheckEntry(const std::string& filename, Anitomy& anitomy) {
+  const element_category_mask_t title_and_episode =
+      ElementCategoryMask(kElementAnimeTitle) |
+      ElementCategoryMask(kElementEpisodeNumber);
+  CheckSink(filename, anitomy, kElementCategoryMaskAll);
+  CheckSink(filename, anitomy, title_and_episode);
+}
+
+// A copy keeps what it is given, instead of passing it to the sink of the
+// original, which may be gone by then
+static void CheckCopy() {
+  CollectingSink sink;
+  Elements elements;
+  elements.set_sink(&sink, kElementCategoryMaskAll);
+  Elements copy(elements);
+  Elements assigned;
+  assigned = elements;
+  copy.insert(kElementAnimeTitle, L"Title");
+  assigned.insert(kElementAnimeTitle, L"Title");
+  if (!sink.elements.empty() || copy.size() != 1 || assigned.size() != 1)
+    Fail("copy of Elements", "copy kept the sink");
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<TestEntry> entries;
+  if (!LoadTestEntries(argc, argv, entries))
+    return 1;
+
+  CheckCopy();
+
+  Anitomy anitomy;
+  ForEachTestEntry(entries, anitomy, CheckEntry);
+
+  return ReportTestResults(entries.size());
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Parses every entry in test/data.json from a buffer and checks the source
+// ranges of the elements: a value that is not a title must be the exact text
+// at its range, data() and length() must agree with the value, and a copy of
+// the elements must keep its values after the next parse.
+
+#include "../anitomy/anitomy.h"
+#include "../tools/common/test_runner.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+static bool IsTitle(ElementCategory category) {
+  return category == kElementAnimeTitle || category == kElementEpisodeTitle;
+}
+
+// Keeps a copy of the previous result, to see that it survives the next parse
+struct CheckRanges {
+  void operator()(const std::string& filename, Anitomy& anitomy);
+
+  Elements copy;
+  std::vector<string_t> copy_values;
+};
+
+void CheckRanges::operator()(const std::string& filename, Anitomy& anitomy) {
+  const string_t input = Utf8ToString(filename);
+
+  // The elements must not refer to the caller's buffer
+  string_t buffer = input;
+  anitomy.Parse(StringView(buffer.data(), buffer.size()));
+  buffer.assign(buffer.size(), L'?');
+  // Only read through const member functions, which must see every value
+  const Elements& elements = anitomy.elements();
+
+  // Ranges refer to the filename as it was parsed, which is a prefix of the
+  // input unless some strings were ignored. Apart from the file name, values
+  // are taken from its normalized form, which has the same offsets.
+  const bool checked = anitomy.options().ignored_strings.empty();
+  string_t normalized = input;
+  if (anitomy.options().normalize_width)
+    NormalizeWidth(normalized);
+
+  std::vector<string_t> views;
+  for (size_t i = 0; i < elements.size(); ++i)
+    views.push_back(string_t(elements.data(i), elements.length(i)));
+
+  for (size_t i = 0; i < elements.size(); ++i) {
+    const string_t& view = views[i];
+    TokenRange range;
+    if (elements.get_range(i, range)) {
+      if (range.offset + range.size > input.size()) {
+        Fail(filename, "range is out of bounds");
+      } else if (checked && !IsTitle(elements[i].first) &&
+                 (elements[i].first == kElementFileName ? input : normalized)
+                         .compare(range.offset, range.size, view) != 0) {
+        Fail(filename, "value differs from the text at its range");
+      }
+    }
+    if (view != elements[i].second)
+      Fail(filename, "data() differs from the value");
+  }
+
+  for (size_t i = 0; i < copy.size(); ++i)
+    if (copy[i].second != copy_values[i])
+      Fail(filename, "copy lost its value after the next parse");
+
+  copy = elements;
+  copy_values.clear();
+  for (size_t i = 0; i < elements.size(); ++i)
+    copy_values.push_back(elements[i].second);
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<TestEntry> entries;
+  if (!LoadTestEntries(argc, argv, entries))
+    return 1;
+
+  Anitomy anitomy;
+  CheckRanges check;
+  ForEachTestEntry(entries, anitomy, check);
+
+  return ReportTestResults(entries.size());
+}
\ No newline at end of file
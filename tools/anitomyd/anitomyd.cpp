@@ -0,0 +1,552 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include "../../anitomy/anitomy.h"
+#include "../common/arguments.h"
+#include "protocol.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+// Metrics
+
+const double kLatencyBuckets[] = {
+  0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005,
+  0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1
+};
+
+struct Metrics {
+  uint64_t connections_total;
+  uint64_t connections_active;
+  uint64_t requests_total;
+  uint64_t parse_failures_total;
+  uint64_t bad_requests_total;
+  uint64_t batches_total;
+  uint64_t parse_nanoseconds_total;
+  uint64_t received_bytes_total;
+  uint64_t sent_bytes_total;
+  uint64_t latency_buckets[_countof(kLatencyBuckets) + 1];
+  uint64_t latency_nanoseconds_sum;
+  uint64_t latency_count;
+};
+
+Metrics metrics;
+
+inline void Increment(uint64_t& counter, uint64_t value = 1) {
+  __sync_fetch_and_add(&counter, value);
+}
+
+inline uint64_t Load(const uint64_t& counter) {
+  return __sync_fetch_and_add(const_cast<uint64_t*>(&counter), 0);
+}
+
+void ObserveLatency(uint64_t nanoseconds) {
+  const double seconds = nanoseconds / 1e9;
+  size_t bucket = 0;
+  while (bucket < _countof(kLatencyBuckets) && seconds > kLatencyBuckets[bucket])
+    ++bucket;
+  Increment(metrics.latency_buckets[bucket]);
+  Increment(metrics.latency_nanoseconds_sum, nanoseconds);
+  Increment(metrics.latency_count);
+}
+
+void WriteCounter(std::ostringstream& out, const char* name, const char* type,
+                  const char* help, uint64_t value) {
+  out << "# HELP " << name << " " << help << "\n"
+      << "# TYPE " << name << " " << type << "\n"
+      << name << " " << value << "\n";
+}
+
+std::string FormatMetrics() {
+  std::ostringstream out;
+
+  WriteCounter(out, "anitomyd_connections_total", "counter",
+               "Connections accepted.", Load(metrics.connections_total));
+  WriteCounter(out, "anitomyd_connections_active", "gauge",
+               "Connections currently open.", Load(metrics.connections_active));
+  WriteCounter(out, "anitomyd_requests_total", "counter",
+               "Parse requests received.", Load(metrics.requests_total));
+  WriteCounter(out, "anitomyd_parse_failures_total", "counter",
+               "Parse requests that did not yield an anime title.",
+               Load(metrics.parse_failures_total));
+  WriteCounter(out, "anitomyd_bad_requests_total", "counter",
+               "Malformed requests.", Load(metrics.bad_requests_total));
+  WriteCounter(out, "anitomyd_batches_total", "counter",
+               "Batches handed to parser threads.", Load(metrics.batches_total));
+  WriteCounter(out, "anitomyd_received_bytes_total", "counter",
+               "Bytes received.", Load(metrics.received_bytes_total));
+  WriteCounter(out, "anitomyd_sent_bytes_total", "counter",
+               "Bytes sent.", Load(metrics.sent_bytes_total));
+
+  out << "# HELP anitomyd_parse_seconds_total Time spent in Anitomy::Parse.\n"
+      << "# TYPE anitomyd_parse_seconds_total counter\n"
+      << "anitomyd_parse_seconds_total "
+      << Load(metrics.parse_nanoseconds_total) / 1e9 << "\n";
+
+  const char* name = "anitomyd_request_duration_seconds";
+  out << "# HELP " << name << " Time from receiving a request until its "
+      << "response is written.\n"
+      << "# TYPE " << name << " histogram\n";
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < _countof(kLatencyBuckets); ++i) {
+    cumulative += Load(metrics.latency_buckets[i]);
+    out << name << "_bucket{le=\"" << kLatencyBuckets[i] << "\"} "
+        << cumulative << "\n";
+  }
+  cumulative += Load(metrics.latency_buckets[_countof(kLatencyBuckets)]);
+  out << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n"
+      << name << "_sum " << Load(metrics.latency_nanoseconds_sum) / 1e9 << "\n"
+      << name << "_count " << Load(metrics.latency_count) << "\n";
+
+  return out.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Connections and jobs
+
+size_t max_in_flight = 256;
+
+// A connection is shared by its reader and writer threads and every job in
+// flight; it is closed when the last of them lets go of it.
+//
+// Responses are queued for the writer thread, so that a client that is slow
+// to read never blocks a parser thread. A request is in flight from the
+// moment it is read until its response is written; once `max_in_flight` are,
+// the reader stops taking requests, and the client's writes back up into
+// its socket.
+struct Connection {
+  explicit Connection(int fd)
+      : fd(fd), references(1), in_flight(0), reading(true) {
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&output_ready, NULL);
+    pthread_cond_init(&capacity, NULL);
+  }
+  ~Connection() {
+    pthread_cond_destroy(&capacity);
+    pthread_cond_destroy(&output_ready);
+    pthread_mutex_destroy(&mutex);
+    close(fd);
+  }
+
+  // `received` holds the receive times of the parse requests that `data`
+  // answers, if any
+  void Send(const std::string& data,
+            const std::vector<uint64_t>& received = std::vector<uint64_t>()) {
+    pthread_mutex_lock(&mutex);
+    output.append(data);
+    output_received.insert(output_received.end(), received.begin(), received.end());
+    pthread_cond_signal(&output_ready);
+    pthread_mutex_unlock(&mutex);
+  }
+
+  void BeginRequest() {
+    pthread_mutex_lock(&mutex);
+    ++in_flight;
+    pthread_mutex_unlock(&mutex);
+  }
+
+  // Blocks until another request may be taken
+  void WaitForCapacity() {
+    pthread_mutex_lock(&mutex);
+    while (in_flight >= max_in_flight)
+      pthread_cond_wait(&capacity, &mutex);
+    pthread_mutex_unlock(&mutex);
+  }
+
+  bool HasCapacity() {
+    pthread_mutex_lock(&mutex);
+    const bool result = in_flight < max_in_flight;
+    pthread_mutex_unlock(&mutex);
+    return result;
+  }
+
+  // The writer finishes once every request read so far has been answered
+  void StopReading() {
+    pthread_mutex_lock(&mutex);
+    reading = false;
+    pthread_cond_signal(&output_ready);
+    pthread_mutex_unlock(&mutex);
+  }
+
+  void WriteResponses() {
+    std::string data;
+    std::vector<uint64_t> received;
+    bool broken = false;
+
+    pthread_mutex_lock(&mutex);
+    for (;;) {
+      while (output.empty() && (reading || in_flight > 0))
+        pthread_cond_wait(&output_ready, &mutex);
+      if (output.empty())
+        break;
+      data.swap(output);
+      received.swap(output_received);
+      pthread_mutex_unlock(&mutex);
+
+      // Once the client is gone, responses are only counted off, and the
+      // reader is woken up
+      if (!broken) {
+        if (WriteAll(fd, data.data(), data.size())) {
+          Increment(metrics.sent_bytes_total, data.size());
+        } else {
+          broken = true;
+          shutdown(fd, SHUT_RDWR);
+        }
+      }
+      const uint64_t now = MonotonicNanoseconds();
+      for (std::vector<uint64_t>::const_iterator time = received.begin(); time != received.end(); ++time)
+        ObserveLatency(now - *time);
+
+      pthread_mutex_lock(&mutex);
+      in_flight -= received.size();
+      pthread_cond_signal(&capacity);
+      data.clear();
+      received.clear();
+    }
+    pthread_mutex_unlock(&mutex);
+  }
+
+  void AddRef() {
+    __sync_fetch_and_add(&references, 1);
+  }
+  void Release() {
+    if (__sync_sub_and_fetch(&references, 1) == 0)
+      delete this;
+  }
+
+  int fd;
+  int references;
+  pthread_mutex_t mutex;
+  pthread_cond_t output_ready;
+  pthread_cond_t capacity;
+  std::string output;
+  std::vector<uint64_t> output_received;
+  size_t in_flight;
+  bool reading;
+};
+
+struct Job {
+  Connection* connection;
+  uint32_t id;
+  std::string filename;
+  uint64_t received;
+};
+
+class JobQueue {
+public:
+  JobQueue() {
+    pthread_mutex_init(&mutex_, NULL);
+    pthread_cond_init(&cond_, NULL);
+  }
+
+  void Push(std::vector<Job>& jobs) {
+    if (jobs.empty())
+      return;
+    pthread_mutex_lock(&mutex_);
+    jobs_.insert(jobs_.end(), jobs.begin(), jobs.end());
+    pthread_cond_broadcast(&cond_);
+    pthread_mutex_unlock(&mutex_);
+    jobs.clear();
+  }
+
+  // Blocks until there is work, then takes up to `max_size` jobs at once
+  void PopBatch(std::vector<Job>& batch, size_t max_size) {
+    pthread_mutex_lock(&mutex_);
+    while (jobs_.empty())
+      pthread_cond_wait(&cond_, &mutex_);
+    const size_t size = jobs_.size() < max_size ? jobs_.size() : max_size;
+    batch.assign(jobs_.begin(), jobs_.begin() + size);
+    jobs_.erase(jobs_.begin(), jobs_.begin() + size);
+    pthread_mutex_unlock(&mutex_);
+  }
+
+private:
+  std::deque<Job> jobs_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t cond_;
+};
+
+JobQueue job_queue;
+size_t max_batch_size = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+// Threads
+
+void AppendResponseHeader(std::string& buffer, Status status, uint32_t id) {
+  buffer.push_back(static_cast<char>(status));
+  AppendUint32(buffer, id);
+}
+
+struct Response {
+  std::string data;
+  std::vector<uint64_t> received;
+};
+
+void* WorkerThread(void*) {
+  Anitomy anitomy;
+  std::vector<Job> batch;
+  std::map<Connection*, Response> responses;
+
+  for (;;) {
+    job_queue.PopBatch(batch, max_batch_size);
+    Increment(metrics.batches_total);
+
+    for (std::vector<Job>::const_iterator job = batch.begin(); job != batch.end(); ++job) {
+      const uint64_t parse_begin = MonotonicNanoseconds();
+      bool parsed = false;
+      try {
+        parsed = anitomy.Parse(Utf8ToString(job->filename));
+      } catch (...) {
+        // A single bad filename must not take the daemon down
+      }
+      Increment(metrics.parse_nanoseconds_total,
+                MonotonicNanoseconds() - parse_begin);
+      if (!parsed)
+        Increment(metrics.parse_failures_total);
+
+      Response& response = responses[job->connection];
+      response.received.push_back(job->received);
+      std::string& buffer = response.data;
+      const size_t frame = BeginFrame(buffer);
+      AppendResponseHeader(buffer, parsed ? kStatusOk : kStatusParseFailed, job->id);
+      const Elements& elements = anitomy.elements();
+      AppendVarint(buffer, static_cast<uint32_t>(elements.size()));
+      for (element_const_iterator_t element = elements.begin(); element != elements.end(); ++element) {
+        const std::string value = StringToUtf8(element->second);
+        buffer.push_back(static_cast<char>(element->first));
+        AppendVarint(buffer, static_cast<uint32_t>(value.size()));
+        buffer.append(value);
+      }
+      EndFrame(buffer, frame);
+    }
+
+    // One write per connection and batch
+    for (std::map<Connection*, Response>::iterator response = responses.begin(); response != responses.end(); ++response) {
+      response->first->Send(response->second.data, response->second.received);
+    }
+    for (std::vector<Job>::const_iterator job = batch.begin(); job != batch.end(); ++job)
+      job->connection->Release();
+
+    responses.clear();
+    batch.clear();
+  }
+
+  return NULL;
+}
+
+void* WriterThread(void* param) {
+  Connection* connection = static_cast<Connection*>(param);
+  connection->WriteResponses();
+  connection->Release();
+  return NULL;
+}
+
+void* ReaderThread(void* param) {
+  Connection* connection = static_cast<Connection*>(param);
+  Increment(metrics.connections_total);
+  Increment(metrics.connections_active);
+
+  FrameReader reader;
+  std::vector<Job> jobs;
+  char buffer[16 * 1024];
+  bool throttled = false;
+
+  for (;;) {
+    // Requests that were held back are taken before reading any more
+    if (throttled) {
+      connection->WaitForCapacity();
+    } else {
+      const ssize_t size = read(connection->fd, buffer, sizeof(buffer));
+      if (size == -1 && errno == EINTR)
+        continue;
+      if (size <= 0)
+        break;
+      Increment(metrics.received_bytes_total, size);
+      reader.Append(buffer, size);
+    }
+
+    const uint64_t now = MonotonicNanoseconds();
+    const char* payload = NULL;
+    size_t payload_size = 0;
+    bool error = false;
+
+    // Everything that arrived in one read is queued at once, up to the limit
+    throttled = !connection->HasCapacity();
+    while (!throttled && reader.Next(payload, payload_size, error)) {
+      if (payload_size < kRequestHeaderSize) {
+        Increment(metrics.bad_requests_total);
+        continue;
+      }
+      const uint8_t opcode = static_cast<uint8_t>(payload[0]);
+      const uint32_t id = ReadUint32(payload + 1);
+
+      if (opcode == kOpParse) {
+        Increment(metrics.requests_total);
+        Job job;
+        job.connection = connection;
+        job.id = id;
+        job.filename.assign(payload + kRequestHeaderSize,
+                            payload_size - kRequestHeaderSize);
+        job.received = now;
+        connection->AddRef();
+        connection->BeginRequest();
+        jobs.push_back(job);
+        throttled = !connection->HasCapacity();
+      } else {
+        std::string response;
+        const size_t frame = BeginFrame(response);
+        if (opcode == kOpMetrics) {
+          AppendResponseHeader(response, kStatusOk, id);
+          response.append(FormatMetrics());
+        } else {
+          Increment(metrics.bad_requests_total);
+          AppendResponseHeader(response, kStatusBadRequest, id);
+        }
+        EndFrame(response, frame);
+        connection->Send(response);
+      }
+    }
+    job_queue.Push(jobs);
+
+    if (error) {
+      Increment(metrics.bad_requests_total);
+      break;
+    }
+  }
+
+  connection->StopReading();
+  __sync_fetch_and_sub(&metrics.connections_active, 1);
+  connection->Release();
+  return NULL;
+}
+
+volatile sig_atomic_t stop_requested = 0;
+
+void OnSignal(int) {
+  stop_requested = 1;
+}
+
+int PrintUsage() {
+  std::fprintf(stderr,
+      "Usage: anitomyd [--socket path] [--threads n] [--batch n] [--in-flight n]\n"
+      "\n"
+      "  --socket   Unix domain socket to listen on (default: /tmp/anitomyd.sock)\n"
+      "  --threads  Number of parser threads (default: 4)\n"
+      "  --batch    Maximum number of requests per batch (default: 64)\n"
+      "  --in-flight  Maximum number of unanswered requests per connection\n"
+      "               (default: 256)\n");
+  return 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string socket_path = "/tmp/anitomyd.sock";
+  size_t thread_count = 4;
+
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && std::strcmp(argv[i], "--socket") == 0) {
+      socket_path = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--threads") == 0) {
+      if (!ParseCount(argv[++i], 1024, thread_count))
+        return PrintUsage();
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--batch") == 0) {
+      if (!ParseCount(argv[++i], 64 * 1024, max_batch_size))
+        return PrintUsage();
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--in-flight") == 0) {
+      if (!ParseCount(argv[++i], 64 * 1024, max_in_flight))
+        return PrintUsage();
+    } else {
+      return PrintUsage();
+    }
+  }
+
+  struct sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    std::fprintf(stderr, "Socket path is too long\n");
+    return 1;
+  }
+  std::strcpy(address.sun_path, socket_path.c_str());
+
+  const int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  unlink(socket_path.c_str());
+  if (listen_fd == -1 ||
+      bind(listen_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == -1 ||
+      listen(listen_fd, SOMAXCONN) == -1) {
+    std::perror("anitomyd");
+    return 1;
+  }
+
+  // Without SA_RESTART, so that accept() is interrupted
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_handler = OnSignal;
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  pthread_attr_t attributes;
+  pthread_attr_init(&attributes);
+  pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    pthread_t thread;
+    pthread_create(&thread, &attributes, WorkerThread, NULL);
+  }
+
+  while (!stop_requested) {
+    const int fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (fd == -1)
+      continue;
+    pthread_t thread;
+    Connection* connection = new Connection(fd);
+    connection->AddRef();
+    if (pthread_create(&thread, &attributes, WriterThread, connection) != 0) {
+      connection->Release();
+      connection->Release();
+      continue;
+    }
+    if (pthread_create(&thread, &attributes, ReaderThread, connection) != 0) {
+      connection->StopReading();
+      connection->Release();
+    }
+  }
+
+  close(listen_fd);
+  unlink(socket_path.c_str());
+
+  return 0;
+}
\ No newline at end of file
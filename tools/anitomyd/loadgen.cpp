@@ -0,0 +1,321 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../common/arguments.h"
+#include "protocol.h"
+
+using namespace anitomy::tools;
+
+namespace {
+
+const char* const kDefaultFilenames[] = {
+  "[TaigaSubs]_Toradora!_(2008)_-_01v2_-_Tiger_and_Dragon_[1280x720_H.264_FLAC][1234ABCD].mkv",
+  "[Ouroboros]_Fullmetal_Alchemist_Brotherhood_-_01.mkv",
+  "Spice_and_Wolf_Ep01_[1080p,BluRay,x264]_-_THORA.mkv",
+  "[ANBU-Menclave]_Canaan_-_01_[1024x576_H.264_AAC][12F00E89].mkv",
+  "[chibi-Doki] Seikon no Qwaser - 13v0 (Uncensored Director's Cut) [988DB090].mkv",
+  "Evangelion The New Movie Q (BD 1280x720 AVC AACx2 [5.1+2.0]).mp4",
+  "[Hatsuyuki]_Kuroko_no_Basuke_S3_-_01_(51)_[720p][10C7B1BA].mkv",
+  "Noein_[01_of_24]_[ElfFansubs].avi",
+};
+
+struct Options {
+  std::string socket_path;
+  std::vector<std::string> filenames;
+  size_t requests;
+  size_t pipeline;
+};
+
+// Each connection has a sender and a receiver thread. The sender keeps up to
+// `pipeline` requests in flight.
+struct Client {
+  const Options* options;
+  int fd;
+  size_t requests;
+  size_t in_flight;
+  std::vector<uint64_t> sent;
+  std::vector<uint64_t> latencies;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  bool failed;
+};
+
+void* SenderThread(void* param) {
+  Client& client = *static_cast<Client*>(param);
+  const std::vector<std::string>& filenames = client.options->filenames;
+  std::string buffer;
+
+  for (size_t id = 0; id < client.requests; ) {
+    pthread_mutex_lock(&client.mutex);
+    while (client.in_flight >= client.options->pipeline && !client.failed)
+      pthread_cond_wait(&client.cond, &client.mutex);
+    const size_t available = client.options->pipeline - client.in_flight;
+    const bool failed = client.failed;
+    pthread_mutex_unlock(&client.mutex);
+    if (failed)
+      break;
+
+    // Send as many requests as the window allows in a single write
+    buffer.clear();
+    const uint64_t now = MonotonicNanoseconds();
+    const size_t end = std::min(client.requests, id + available);
+    for (size_t i = id; i < end; ++i) {
+      const std::string& filename = filenames[i % filenames.size()];
+      const size_t frame = BeginFrame(buffer);
+      buffer.push_back(static_cast<char>(kOpParse));
+      AppendUint32(buffer, static_cast<uint32_t>(i));
+      buffer.append(filename);
+      EndFrame(buffer, frame);
+      client.sent[i] = now;
+    }
+
+    pthread_mutex_lock(&client.mutex);
+    client.in_flight += end - id;
+    pthread_mutex_unlock(&client.mutex);
+    id = end;
+
+    if (!WriteAll(client.fd, buffer.data(), buffer.size()))
+      break;
+  }
+
+  return NULL;
+}
+
+void* ReceiverThread(void* param) {
+  Client& client = *static_cast<Client*>(param);
+  FrameReader reader;
+  char buffer[64 * 1024];
+  size_t received = 0;
+
+  while (received < client.requests) {
+    const ssize_t size = read(client.fd, buffer, sizeof(buffer));
+    if (size <= 0)
+      break;
+    reader.Append(buffer, size);
+
+    const uint64_t now = MonotonicNanoseconds();
+    const char* payload = NULL;
+    size_t payload_size = 0;
+    bool error = false;
+    size_t count = 0;
+    while (reader.Next(payload, payload_size, error)) {
+      if (payload_size < kResponseHeaderSize)
+        continue;
+      const uint32_t id = ReadUint32(payload + 1);
+      if (id < client.requests)
+        client.latencies.push_back(now - client.sent[id]);
+      ++count;
+    }
+    if (error)
+      break;
+
+    received += count;
+    pthread_mutex_lock(&client.mutex);
+    client.in_flight -= count;
+    pthread_cond_signal(&client.cond);
+    pthread_mutex_unlock(&client.mutex);
+  }
+
+  pthread_mutex_lock(&client.mutex);
+  client.failed = received < client.requests;
+  pthread_cond_signal(&client.cond);
+  pthread_mutex_unlock(&client.mutex);
+
+  return NULL;
+}
+
+int Connect(const std::string& socket_path) {
+  struct sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1)
+    return -1;
+  if (connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == -1) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+bool PrintMetrics(const std::string& socket_path) {
+  const int fd = Connect(socket_path);
+  if (fd == -1)
+    return false;
+
+  std::string request;
+  const size_t frame = BeginFrame(request);
+  request.push_back(static_cast<char>(kOpMetrics));
+  AppendUint32(request, 0);
+  EndFrame(request, frame);
+  WriteAll(fd, request.data(), request.size());
+
+  FrameReader reader;
+  char buffer[16 * 1024];
+  const char* payload = NULL;
+  size_t payload_size = 0;
+  bool error = false;
+  bool result = false;
+  while (!result && !error) {
+    const ssize_t size = read(fd, buffer, sizeof(buffer));
+    if (size <= 0)
+      break;
+    reader.Append(buffer, size);
+    if (reader.Next(payload, payload_size, error) &&
+        payload_size >= kResponseHeaderSize) {
+      std::fwrite(payload + kResponseHeaderSize, 1,
+                  payload_size - kResponseHeaderSize, stdout);
+      result = true;
+    }
+  }
+
+  close(fd);
+  return result;
+}
+
+double Percentile(const std::vector<uint64_t>& sorted, double p) {
+  if (sorted.empty())
+    return 0.0;
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[index] / 1000.0;
+}
+
+int PrintUsage() {
+  std::fprintf(stderr,
+      "Usage: anitomyd-loadgen [--socket path] [--connections n] [--requests n]\n"
+      "                        [--pipeline n] [--input file] [--metrics]\n"
+      "\n"
+      "  --socket       Socket of the daemon (default: /tmp/anitomyd.sock)\n"
+      "  --connections  Number of concurrent connections (default: 4)\n"
+      "  --requests     Requests per connection (default: 100000)\n"
+      "  --pipeline     Requests in flight per connection (default: 32)\n"
+      "  --input        File with one filename per line\n"
+      "  --metrics      Print the daemon's counters afterwards\n");
+  return 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  options.socket_path = "/tmp/anitomyd.sock";
+  options.requests = 100000;
+  options.pipeline = 32;
+  size_t connections = 4;
+  bool print_metrics = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && std::strcmp(argv[i], "--socket") == 0) {
+      options.socket_path = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--connections") == 0) {
+      if (!ParseCount(argv[++i], 1024, connections))
+        return PrintUsage();
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--requests") == 0) {
+      // Request IDs are 32-bit
+      if (!ParseCount(argv[++i], 0xFFFFFFFF, options.requests))
+        return PrintUsage();
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--pipeline") == 0) {
+      if (!ParseCount(argv[++i], 64 * 1024, options.pipeline))
+        return PrintUsage();
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--input") == 0) {
+      std::ifstream file(argv[++i]);
+      std::string line;
+      while (std::getline(file, line))
+        if (!line.empty())
+          options.filenames.push_back(line);
+    } else if (std::strcmp(argv[i], "--metrics") == 0) {
+      print_metrics = true;
+    } else {
+      return PrintUsage();
+    }
+  }
+  if (options.filenames.empty())
+    options.filenames.assign(kDefaultFilenames,
+                             kDefaultFilenames + sizeof(kDefaultFilenames) / sizeof(kDefaultFilenames[0]));
+
+  signal(SIGPIPE, SIG_IGN);
+
+  std::vector<Client> clients(connections);
+  for (size_t i = 0; i < clients.size(); ++i) {
+    Client& client = clients[i];
+    client.options = &options;
+    client.fd = Connect(options.socket_path);
+    if (client.fd == -1) {
+      std::perror("anitomyd-loadgen");
+      return 1;
+    }
+    client.requests = options.requests;
+    client.in_flight = 0;
+    client.sent.resize(options.requests);
+    client.latencies.reserve(options.requests);
+    client.failed = false;
+    pthread_mutex_init(&client.mutex, NULL);
+    pthread_cond_init(&client.cond, NULL);
+  }
+
+  const uint64_t begin = MonotonicNanoseconds();
+  std::vector<pthread_t> threads;
+  for (size_t i = 0; i < clients.size(); ++i) {
+    pthread_t thread;
+    pthread_create(&thread, NULL, SenderThread, &clients[i]);
+    threads.push_back(thread);
+    pthread_create(&thread, NULL, ReceiverThread, &clients[i]);
+    threads.push_back(thread);
+  }
+  for (size_t i = 0; i < threads.size(); ++i)
+    pthread_join(threads[i], NULL);
+  const double seconds = (MonotonicNanoseconds() - begin) / 1e9;
+
+  std::vector<uint64_t> latencies;
+  for (size_t i = 0; i < clients.size(); ++i) {
+    latencies.insert(latencies.end(), clients[i].latencies.begin(),
+                     clients[i].latencies.end());
+    close(clients[i].fd);
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  std::printf("requests:    %lu (%lu failed)\n",
+              static_cast<unsigned long>(latencies.size()),
+              static_cast<unsigned long>(connections * options.requests - latencies.size()));
+  std::printf("throughput:  %.0f requests/s\n", latencies.size() / seconds);
+  std::printf("latency:     p50 %.1f us, p99 %.1f us, p999 %.1f us, max %.1f us\n",
+              Percentile(latencies, 0.50), Percentile(latencies, 0.99),
+              Percentile(latencies, 0.999), Percentile(latencies, 1.0));
+
+  if (print_metrics) {
+    std::printf("\n");
+    PrintMetrics(options.socket_path);
+  }
+
+  return latencies.size() == connections * options.requests ? 0 : 1;
+}
\ No newline at end of file
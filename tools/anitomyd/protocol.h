@@ -0,0 +1,177 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_PROTOCOL_H
+#define ANITOMY_TOOLS_PROTOCOL_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+
+// Every message is a frame: a little-endian uint32 payload length, followed
+// by the payload. Clients may send any number of requests without waiting
+// for a response; responses carry the request ID and may arrive out of order.
+//
+// Request payload:
+//   uint8   opcode
+//   uint32  request ID
+//   ...     opcode-specific data (kOpParse: UTF-8 filename)
+//
+// Response payload:
+//   uint8   status
+//   uint32  request ID
+//   ...     kOpParse: varint element count, then for each element a category
+//           byte, a varint length and UTF-8 data
+//           kOpMetrics: counters in Prometheus text format
+
+namespace anitomy {
+namespace tools {
+
+enum Opcode {
+  kOpParse = 1,
+  kOpMetrics = 2
+};
+
+enum Status {
+  kStatusOk = 0,
+  kStatusParseFailed = 1,  // Elements are still included
+  kStatusBadRequest = 2
+};
+
+const size_t kFrameHeaderSize = 4;
+const size_t kRequestHeaderSize = 1 + 4;
+const size_t kResponseHeaderSize = 1 + 4;
+const size_t kMaxFrameSize = 64 * 1024;
+
+inline void AppendUint32(std::string& buffer, uint32_t value) {
+  buffer.push_back(static_cast<char>(value & 0xFF));
+  buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+  buffer.push_back(static_cast<char>((value >> 16) & 0xFF));
+  buffer.push_back(static_cast<char>((value >> 24) & 0xFF));
+}
+
+inline uint32_t ReadUint32(const char* data) {
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+  return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline void AppendVarint(std::string& buffer, uint32_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+// Returns the number of bytes read, or 0 if the data is truncated
+inline size_t ReadVarint(const char* data, size_t size, uint32_t& value) {
+  value = 0;
+  for (size_t i = 0; i < size && i < 5; ++i) {
+    const unsigned char byte = static_cast<unsigned char>(data[i]);
+    value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+    if (!(byte & 0x80))
+      return i + 1;
+  }
+  return 0;
+}
+
+// Reserves room for the frame header, to be filled in by EndFrame()
+inline size_t BeginFrame(std::string& buffer) {
+  const size_t position = buffer.size();
+  buffer.append(kFrameHeaderSize, '\0');
+  return position;
+}
+
+inline void EndFrame(std::string& buffer, size_t position) {
+  const uint32_t size =
+      static_cast<uint32_t>(buffer.size() - position - kFrameHeaderSize);
+  for (size_t i = 0; i < kFrameHeaderSize; ++i)
+    buffer[position + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+}
+
+// Extracts complete frames out of a stream of bytes
+class FrameReader {
+public:
+  FrameReader() : begin_(0) {}
+
+  void Append(const char* data, size_t size) {
+    if (begin_ > 0 && begin_ == buffer_.size()) {
+      buffer_.clear();
+      begin_ = 0;
+    }
+    buffer_.append(data, size);
+  }
+
+  // Returns false if no complete frame is available. Sets `error` if the
+  // stream is malformed.
+  bool Next(const char*& payload, size_t& size, bool& error) {
+    error = false;
+    if (buffer_.size() - begin_ < kFrameHeaderSize)
+      return Compact();
+    size = ReadUint32(buffer_.data() + begin_);
+    if (size > kMaxFrameSize) {
+      error = true;
+      return false;
+    }
+    if (buffer_.size() - begin_ - kFrameHeaderSize < size)
+      return Compact();
+    payload = buffer_.data() + begin_ + kFrameHeaderSize;
+    begin_ += kFrameHeaderSize + size;
+    return true;
+  }
+
+private:
+  bool Compact() {
+    if (begin_ > 0) {
+      buffer_.erase(0, begin_);
+      begin_ = 0;
+    }
+    return false;
+  }
+
+  std::string buffer_;
+  size_t begin_;
+};
+
+inline bool WriteAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t written = write(fd, data, size);
+    if (written == -1) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+inline uint64_t MonotonicNanoseconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_PROTOCOL_H
\ No newline at end of file
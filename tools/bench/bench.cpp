@@ -0,0 +1,432 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/anitomy.h"
+#include "../../anitomy/string_pool.h"
+#include "../common/arguments.h"
+#include "../common/corpus.h"
+#include "../common/element_name.h"
+#include "bench.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+static int PrintUsage() {
+  std::fprintf(stderr,
+      "Usage: anitomy-bench <command> [--count n] [--adversarial n] [--seed n]\n"
+      "                                [--mixed-script n]\n"
+      "                                [--series n] [--episodes n]\n"
+      "                                [--input file] [--iterations n]\n"
+      "                                [--max-work n] [--max-ns n]\n"
+      "                                [--categories name,...]\n"
+      "                                [--profile runtime|default] [--sink]\n"
+      "                                [--view] [--processes n]\n"
+      "                                [--output file]\n"
+      "       anitomy-bench compare <base.json> <current.json> [--threshold n]\n"
+      "\n"
+      "corpus  writes --count filenames of the standard corpus, with\n"
+      "        --adversarial percent of pathological ones, to --output or\n"
+      "        to stdout; --mixed-script gives that percent of series\n"
+      "        titles in other scripts than Latin\n"
+      "parse   parses the standard corpus (or the filenames in --input, one\n"
+      "        per line) --iterations times and reports throughput, with a\n"
+      "        per-stage and per-rule breakdown if built with\n"
+      "        -DANITOMY_ENABLE_STATS=1; --max-work and --max-ns set a\n"
+      "        work budget for every parse, and --categories requests only\n"
+      "        the given elements (e.g. anime_title,episode_number); with\n"
+      "        --profile default, parses with BasicAnitomy<DefaultProfile>;\n"
+      "        with --sink, streams elements with ParseInto instead of\n"
+      "        reading them from elements(); with --view, passes each\n"
+      "        filename as a StringView instead of a string_t copy\n"
+      "latency records the latency of every parse, --iterations runs over\n"
+      "        the same input, and reports percentiles overall, by filename\n"
+      "        length and by token count; --output writes them as JSON\n"
+      "compare compares two latency result files, and fails if a metric\n"
+      "        got significantly slower by more than --threshold percent\n"
+      "intern  parses a synthetic library and reports how much memory a\n"
+      "        StringPool saves over keeping a copy of every value\n"
+      "startup starts this program --processes times, and reports the\n"
+      "        time from exec to the end of the first parse\n");
+  return 1;
+}
+
+// Fits in size_t and unsigned long on every platform
+static const unsigned long long kMaxCount = 0xFFFFFFFF;
+
+static bool ParseOptions(int argc, char* argv[], int first,
+                         BenchOptions& options) {
+  for (int i = first; i < argc; ++i) {
+    if (i + 1 < argc && std::strcmp(argv[i], "--count") == 0) {
+      if (!ParseCount(argv[++i], kMaxCount, options.count))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--adversarial") == 0) {
+      if (!ParseNumber(argv[++i], 100, options.adversarial))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--mixed-script") == 0) {
+      if (!ParseNumber(argv[++i], 100, options.mixed_script))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--series") == 0) {
+      if (!ParseCount(argv[++i], kMaxCount, options.series))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--episodes") == 0) {
+      if (!ParseCount(argv[++i], kMaxCount, options.episodes))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--seed") == 0) {
+      if (!ParseNumber(argv[++i], UINT_MAX, options.seed))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--iterations") == 0) {
+      if (!ParseCount(argv[++i], kMaxCount, options.iterations))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--max-work") == 0) {
+      if (!ParseNumber(argv[++i], kMaxCount, options.max_work))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--max-ns") == 0) {
+      if (!ParseNumber(argv[++i], ULLONG_MAX, options.max_nanoseconds))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--categories") == 0) {
+      if (!ElementCategoryMaskFromNames(argv[++i], options.categories))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--profile") == 0) {
+      options.profile = argv[++i];
+      if (options.profile != "runtime" && options.profile != "default")
+        return false;
+    } else if (std::strcmp(argv[i], "--sink") == 0) {
+      options.sink = true;
+    } else if (std::strcmp(argv[i], "--view") == 0) {
+      options.view = true;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--processes") == 0) {
+      if (!ParseCount(argv[++i], kMaxCount, options.processes))
+        return false;
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--input") == 0) {
+      options.input = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--output") == 0) {
+      options.output = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--threshold") == 0) {
+      char* end = NULL;
+      options.threshold = std::strtod(argv[++i], &end);
+      if (end == argv[i] || *end != '\0' || !(options.threshold >= 0))
+        return false;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool anitomy::tools::LoadFilenames(const BenchOptions& options,
+                                   std::vector<string_t>& filenames) {
+  if (options.input.empty()) {
+    CorpusGenerator generator(options.seed);
+    generator.set_adversarial_rate(options.adversarial);
+    generator.set_mixed_script_rate(options.mixed_script);
+    generator.Generate(options.count, filenames);
+    return true;
+  }
+
+  std::ifstream file(options.input.c_str());
+  if (!file)
+    return false;
+  std::string line;
+  while (std::getline(file, line))
+    if (!line.empty())
+      filenames.push_back(Utf8ToString(line));
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if ANITOMY_ENABLE_STATS
+static void PrintStageBreakdown(const ParseStats& stats) {
+  const double total = static_cast<double>(stats.nanoseconds[kParseStageTotal]);
+
+  const double parses = static_cast<double>(stats.parses);
+
+  std::printf("%-28s %12s %10s %8s %12s %12s\n", "stage", "calls",
+              "ns/parse", "share", "allocs/parse", "bytes/parse");
+  for (int i = kParseStageTotal; i < kParseStageCount; ++i) {
+    const ParseStage stage = static_cast<ParseStage>(i);
+    std::printf("%-28s %12llu %10.1f %7.1f%% %12.1f %12.1f\n",
+                ParseStageName(stage), stats.calls[i],
+                stats.nanoseconds[i] / parses,
+                total > 0 ? stats.nanoseconds[i] * 100 / total : 0.0,
+                stats.allocations[i] / parses,
+                stats.allocated_bytes[i] / parses);
+  }
+  std::printf("(peek is a part of tokenize)\n");
+  std::printf("peak live bytes in a single parse: %llu\n",
+              stats.peak_live_bytes);
+}
+
+static void PrintRuleBreakdown(const ParseStats& stats) {
+  std::printf("%-28s %12s %12s %8s %10s\n", "episode number rule",
+              "attempts", "hits", "hit rate", "depth");
+  for (int i = 0; i < kParseRuleCount; ++i) {
+    const ParseRule rule = static_cast<ParseRule>(i);
+    std::printf("%-28s %12llu %12llu %7.1f%% ", ParseRuleName(rule),
+                stats.rule_attempts[i], stats.rule_hits[i],
+                stats.rule_attempts[i] ?
+                    stats.rule_hits[i] * 100.0 / stats.rule_attempts[i] : 0.0);
+    if (stats.rule_hits[i]) {
+      std::printf("%10.1f\n",
+                  stats.rule_depth[i] / static_cast<double>(stats.rule_hits[i]));
+    } else {
+      std::printf("%10s\n", "never hit");
+    }
+  }
+  std::printf("(depth is the average number of attempts before a hit)\n");
+}
+#endif
+
+static int WriteCorpus(const BenchOptions& options) {
+  FILE* file = stdout;
+  if (!options.output.empty()) {
+    file = std::fopen(options.output.c_str(), "wb");
+    if (!file) {
+      std::fprintf(stderr, "Cannot write %s\n", options.output.c_str());
+      return 1;
+    }
+  }
+
+  CorpusGenerator generator(options.seed);
+  generator.set_adversarial_rate(options.adversarial);
+  generator.set_mixed_script_rate(options.mixed_script);
+  for (size_t i = 0; i < options.count; ++i) {
+    const std::string filename = generator.NextFilename();
+    std::fwrite(filename.data(), 1, filename.size(), file);
+    std::fputc('\n', file);
+  }
+
+  if (file != stdout)
+    std::fclose(file);
+  return 0;
+}
+
+// Stands in for an index that stores every element as it arrives
+class CountingSink : public ElementSink {
+public:
+  CountingSink() : elements(0), characters(0) {}
+
+  void OnElement(ElementCategory, const char_t*, size_t length) {
+    ++elements;
+    characters += length;
+  }
+
+  size_t elements;
+  size_t characters;
+};
+
+// Either way, every element is handed to the sink
+template <class AnitomyType>
+static bool ParseInto(AnitomyType& anitomy, const string_t& filename,
+                      CountingSink& sink, const BenchOptions& options) {
+  const StringView view(filename.data(), filename.size());
+  if (options.sink)
+    return options.view ? anitomy.ParseInto(view, sink)
+                        : anitomy.ParseInto(filename, sink);
+
+  const bool result = options.view ? anitomy.Parse(view)
+                                   : anitomy.Parse(filename);
+  const Elements& elements = anitomy.elements();
+  for (element_const_iterator_t element = elements.begin(); element != elements.end(); ++element)
+    sink.OnElement(element->first, element->second.data(),
+                   element->second.size());
+  return result;
+}
+
+template <class AnitomyType>
+static int BenchParse(AnitomyType& anitomy,
+                      const std::vector<string_t>& filenames,
+                      const BenchOptions& options) {
+  anitomy.options().max_work = options.max_work;
+  anitomy.options().max_nanoseconds = options.max_nanoseconds;
+  anitomy.options().requested_categories = options.categories;
+  size_t failures = 0;
+  size_t budget_exceeded = 0;
+  CountingSink sink;
+
+  // Warm up, so that the first pass doesn't pay for page faults
+  for (size_t i = 0; i < filenames.size(); ++i)
+    ParseInto(anitomy, filenames[i], sink, options);
+  anitomy.total_stats().clear();
+
+  const unsigned long long start = GetStatsClock();
+  for (size_t iteration = 0; iteration < options.iterations; ++iteration) {
+    for (size_t i = 0; i < filenames.size(); ++i) {
+      if (!ParseInto(anitomy, filenames[i], sink, options)) {
+        ++failures;
+        if (anitomy.budget_exceeded())
+          ++budget_exceeded;
+      }
+    }
+  }
+  const unsigned long long elapsed = GetStatsClock() - start;
+
+  const double parses =
+      static_cast<double>(filenames.size()) * options.iterations;
+  std::printf("%lu filenames, %lu iterations, %lu failed parses\n",
+              static_cast<unsigned long>(filenames.size()),
+              static_cast<unsigned long>(options.iterations),
+              static_cast<unsigned long>(failures / options.iterations));
+  if (options.max_work || options.max_nanoseconds)
+    std::printf("%lu parses over budget\n",
+                static_cast<unsigned long>(budget_exceeded /
+                                           options.iterations));
+  std::printf("%.0f parses/s, %.1f ns/parse\n\n",
+              parses * 1e9 / elapsed, elapsed / parses);
+
+#if ANITOMY_ENABLE_STATS
+  PrintStageBreakdown(anitomy.total_stats());
+  std::printf("\n");
+  PrintRuleBreakdown(anitomy.total_stats());
+#else
+  std::printf("Build with -DANITOMY_ENABLE_STATS=1 for per-stage and "
+              "per-rule breakdowns.\n");
+#endif
+
+  return 0;
+}
+
+static int BenchParse(const BenchOptions& options) {
+  std::vector<string_t> filenames;
+  if (!LoadFilenames(options, filenames) || filenames.empty()) {
+    std::fprintf(stderr, "Cannot read %s\n", options.input.c_str());
+    return 1;
+  }
+
+  if (options.profile == "default") {
+    BasicAnitomy<DefaultProfile> anitomy;
+    return BenchParse(anitomy, filenames, options);
+  }
+  Anitomy anitomy;
+  return BenchParse(anitomy, filenames, options);
+}
+
+static int BenchIntern(const BenchOptions& options) {
+  std::vector<string_t> filenames;
+  CorpusGenerator(options.seed).GenerateLibrary(options.series,
+                                                options.episodes, filenames);
+
+  Anitomy anitomy;
+  StringPool pool;
+  std::vector<InternedElements> results;
+  results.reserve(filenames.size());
+  size_t elements_size = 0;
+  size_t values[kElementIterateLast] = {0};
+  std::set<string_t> distinct[kElementIterateLast];
+  size_t failures = 0;
+
+  for (size_t i = 0; i < filenames.size(); ++i) {
+    anitomy.Parse(filenames[i]);
+    const Elements& elements = anitomy.elements();
+    elements_size += elements.memory_usage();
+    for (element_const_iterator_t element = elements.begin(); element != elements.end(); ++element) {
+      ++values[element->first];
+      distinct[element->first].insert(element->second);
+    }
+
+    results.push_back(InternedElements());
+    if (!results.back().assign(elements, pool)) {
+      ++failures;
+      continue;
+    }
+
+    Elements restored;
+    results.back().restore(pool, restored);
+    if (restored.size() != elements.size())
+      ++failures;
+  }
+
+  size_t interned_size = pool.memory_usage();
+  for (size_t i = 0; i < results.size(); ++i)
+    interned_size += results[i].memory_usage();
+
+  std::printf("%lu files, %lu values, %lu distinct\n\n",
+              static_cast<unsigned long>(filenames.size()),
+              static_cast<unsigned long>(pool.lookups()),
+              static_cast<unsigned long>(pool.size()));
+  std::printf("%-22s %10s %10s %8s\n", "category", "values", "distinct",
+              "ratio");
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+    if (!values[i])
+      continue;
+    std::printf("%-22s %10lu %10lu %7.1fx\n",
+                ElementCategoryName(static_cast<ElementCategory>(i)),
+                static_cast<unsigned long>(values[i]),
+                static_cast<unsigned long>(distinct[i].size()),
+                values[i] / static_cast<double>(distinct[i].size()));
+  }
+  std::printf("\n");
+  std::printf("value bytes:  %lu requested, %lu stored (%.1fx)\n",
+              static_cast<unsigned long>(pool.requested_bytes()),
+              static_cast<unsigned long>(pool.stored_bytes()),
+              pool.requested_bytes() /
+                  static_cast<double>(pool.stored_bytes()));
+  std::printf("memory:       %lu bytes as Elements (at least), "
+              "%lu bytes interned, %lu bytes saved\n",
+              static_cast<unsigned long>(elements_size),
+              static_cast<unsigned long>(interned_size),
+              static_cast<unsigned long>(elements_size > interned_size ?
+                                         elements_size - interned_size : 0));
+
+  if (failures) {
+    std::printf("%lu results could not be restored\n",
+                static_cast<unsigned long>(failures));
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2)
+    return PrintUsage();
+
+  BenchOptions options;
+
+  if (std::strcmp(argv[1], "first-parse") == 0 && argc == 3)
+    return FirstParse(argv[2]);
+  if (std::strcmp(argv[1], "compare") == 0) {
+    if (argc < 4 || !ParseOptions(argc, argv, 4, options))
+      return PrintUsage();
+    return CompareResults(argv[2], argv[3], options);
+  }
+
+  if (!ParseOptions(argc, argv, 2, options))
+    return PrintUsage();
+
+  if (std::strcmp(argv[1], "corpus") == 0)
+    return WriteCorpus(options);
+  if (std::strcmp(argv[1], "latency") == 0)
+    return BenchLatency(options);
+  if (std::strcmp(argv[1], "parse") == 0)
+    return BenchParse(options);
+  if (std::strcmp(argv[1], "intern") == 0)
+    return BenchIntern(options);
+  if (std::strcmp(argv[1], "startup") == 0)
+    return BenchStartup(options, argv[0]);
+
+  return PrintUsage();
+}
\ No newline at end of file
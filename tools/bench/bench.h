@@ -0,0 +1,71 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_BENCH_H
+#define ANITOMY_TOOLS_BENCH_H
+
+#include <string>
+#include <vector>
+
+#include "../../anitomy/element.h"
+#include "../../anitomy/string.h"
+
+namespace anitomy {
+namespace tools {
+
+struct BenchOptions {
+  BenchOptions()
+      : count(100000), adversarial(2), mixed_script(0), series(2000),
+        episodes(24), seed(1), iterations(5), max_work(0), max_nanoseconds(0),
+        categories(kElementCategoryMaskAll), profile("runtime"),
+        sink(false), view(false), processes(200), threshold(2.0) {}
+
+  size_t count;
+  unsigned int adversarial;  // Percent
+  unsigned int mixed_script;  // Percent
+  size_t series;
+  size_t episodes;
+  unsigned int seed;
+  size_t iterations;
+  size_t max_work;
+  unsigned long long max_nanoseconds;
+  element_category_mask_t categories;
+  std::string profile;  // "runtime" or "default"
+  bool sink;
+  bool view;
+  size_t processes;
+  std::string input;
+  std::string output;
+  double threshold;  // Percent
+};
+
+// Generates the standard corpus, unless an input file is given
+bool LoadFilenames(const BenchOptions& options,
+                   std::vector<string_t>& filenames);
+
+int BenchLatency(const BenchOptions& options);
+int BenchStartup(const BenchOptions& options, const char* program);
+int FirstParse(const char* exec_clock);
+int CompareResults(const std::string& base_path,
+                   const std::string& current_path,
+                   const BenchOptions& options);
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_BENCH_H
\ No newline at end of file
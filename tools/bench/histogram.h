@@ -0,0 +1,116 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_HISTOGRAM_H
+#define ANITOMY_TOOLS_HISTOGRAM_H
+
+#include <vector>
+
+namespace anitomy {
+namespace tools {
+
+// A log-linear histogram in the style of HdrHistogram: values below 32 have
+// a bucket each, and every power of two above that is split into 16 buckets,
+// so any recorded value is off by at most 1/16 (about 6%).
+class LatencyHistogram {
+public:
+  LatencyHistogram() : buckets_(kBucketCount, 0), count_(0), sum_(0), max_(0) {}
+
+  void Record(unsigned long long value) {
+    ++buckets_[GetBucketIndex(value)];
+    ++count_;
+    sum_ += value;
+    if (value > max_)
+      max_ = value;
+  }
+
+  void Merge(const LatencyHistogram& histogram) {
+    for (size_t i = 0; i < kBucketCount; ++i)
+      buckets_[i] += histogram.buckets_[i];
+    count_ += histogram.count_;
+    sum_ += histogram.sum_;
+    if (histogram.max_ > max_)
+      max_ = histogram.max_;
+  }
+
+  // Returns the midpoint of the bucket that holds the given percentile
+  unsigned long long Percentile(double percentile) const {
+    if (count_ == 0)
+      return 0;
+    unsigned long long rank =
+        static_cast<unsigned long long>(count_ * percentile / 100.0 + 0.5);
+    if (rank < 1)
+      rank = 1;
+    unsigned long long seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      seen += buckets_[i];
+      if (seen >= rank) {
+        const unsigned long long value =
+            GetBucketLowerBound(i) + GetBucketWidth(i) / 2;
+        return value < max_ ? value : max_;
+      }
+    }
+    return max_;
+  }
+
+  unsigned long long count() const { return count_; }
+  unsigned long long max() const { return max_; }
+  double mean() const { return count_ ? sum_ / static_cast<double>(count_) : 0; }
+
+private:
+  static const size_t kLinearBuckets = 32;
+  static const size_t kSubBuckets = 16;
+  static const size_t kBucketCount = kLinearBuckets + (64 - 5) * kSubBuckets;
+
+  static size_t GetBucketIndex(unsigned long long value) {
+    if (value < kLinearBuckets)
+      return static_cast<size_t>(value);
+    int msb = 0;
+    while (value >> (msb + 1))
+      ++msb;
+    const int shift = msb - 4;
+    const size_t top = static_cast<size_t>(value >> shift);  // 16..31
+    return kLinearBuckets + (msb - 5) * kSubBuckets + (top - kSubBuckets);
+  }
+
+  static unsigned long long GetBucketLowerBound(size_t index) {
+    if (index < kLinearBuckets)
+      return index;
+    const size_t msb = 5 + (index - kLinearBuckets) / kSubBuckets;
+    const unsigned long long top =
+        kSubBuckets + (index - kLinearBuckets) % kSubBuckets;
+    return top << (msb - 4);
+  }
+
+  static unsigned long long GetBucketWidth(size_t index) {
+    if (index < kLinearBuckets)
+      return 1;
+    const size_t msb = 5 + (index - kLinearBuckets) / kSubBuckets;
+    return 1ULL << (msb - 4);
+  }
+
+  std::vector<unsigned long long> buckets_;
+  unsigned long long count_;
+  double sum_;
+  unsigned long long max_;
+};
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_HISTOGRAM_H
\ No newline at end of file
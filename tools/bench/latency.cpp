@@ -0,0 +1,371 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/anitomy.h"
+#include "../common/json.h"
+#include "bench.h"
+#include "histogram.h"
+
+namespace anitomy {
+namespace tools {
+
+struct LatencyGroup {
+  const char* range;
+  size_t upper_bound;  // Exclusive; 0 for no bound
+};
+
+static const LatencyGroup kLengthGroups[] = {
+  {"0-31", 32},
+  {"32-63", 64},
+  {"64-127", 128},
+  {"128-255", 256},
+  {"256+", 0},
+};
+
+static const LatencyGroup kTokenGroups[] = {
+  {"0-7", 8},
+  {"8-15", 16},
+  {"16-31", 32},
+  {"32-63", 64},
+  {"64+", 0},
+};
+
+static const size_t kGroupCount = _countof(kLengthGroups);
+
+static size_t GetGroupIndex(const LatencyGroup* groups, size_t value) {
+  for (size_t i = 0; i < kGroupCount; ++i)
+    if (!groups[i].upper_bound || value < groups[i].upper_bound)
+      return i;
+  return kGroupCount - 1;
+}
+
+// The statistics that are tracked per run, and compared between results
+static const char* const kRunMetrics[] = {
+  "mean_ns",
+  "p50_ns",
+  "p99_ns",
+  "p999_ns",
+};
+
+static double GetRunMetric(const LatencyHistogram& histogram, size_t metric) {
+  switch (metric) {
+    case 0: return histogram.mean();
+    case 1: return static_cast<double>(histogram.Percentile(50));
+    case 2: return static_cast<double>(histogram.Percentile(99));
+    case 3: return static_cast<double>(histogram.Percentile(99.9));
+  }
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void AppendNumber(std::string& output, double value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.1f", value);
+  output += buffer;
+}
+
+static void AppendCount(std::string& output, unsigned long long value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%llu", value);
+  output += buffer;
+}
+
+static void AppendGroups(std::string& output, const char* name,
+                         const LatencyGroup* groups,
+                         const LatencyHistogram* histograms) {
+  output += ",\n  ";
+  AppendJsonString(output, name);
+  output += ": [";
+  for (size_t i = 0; i < kGroupCount; ++i) {
+    output += i ? ",\n    {\"range\": " : "\n    {\"range\": ";
+    AppendJsonString(output, groups[i].range);
+    output += ", \"count\": ";
+    AppendCount(output, histograms[i].count());
+    output += ", \"p50_ns\": ";
+    AppendNumber(output, static_cast<double>(histograms[i].Percentile(50)));
+    output += ", \"p99_ns\": ";
+    AppendNumber(output, static_cast<double>(histograms[i].Percentile(99)));
+    output += ", \"p999_ns\": ";
+    AppendNumber(output, static_cast<double>(histograms[i].Percentile(99.9)));
+    output += "}";
+  }
+  output += "\n  ]";
+}
+
+static std::string FormatResults(size_t filenames,
+                                 const LatencyHistogram& total,
+                                 const std::vector<LatencyHistogram>& runs,
+                                 const LatencyHistogram* by_length,
+                                 const LatencyHistogram* by_tokens) {
+  std::string output = "{\n  \"version\": 1,\n  \"filenames\": ";
+  AppendCount(output, filenames);
+  output += ",\n  \"runs\": [";
+  for (size_t i = 0; i < runs.size(); ++i) {
+    output += i ? ",\n    {" : "\n    {";
+    for (size_t j = 0; j < _countof(kRunMetrics); ++j) {
+      if (j)
+        output += ", ";
+      AppendJsonString(output, kRunMetrics[j]);
+      output += ": ";
+      AppendNumber(output, GetRunMetric(runs[i], j));
+    }
+    output += "}";
+  }
+  output += "\n  ],\n  \"summary\": {\"count\": ";
+  AppendCount(output, total.count());
+  output += ", \"mean_ns\": ";
+  AppendNumber(output, total.mean());
+  output += ", \"p50_ns\": ";
+  AppendNumber(output, static_cast<double>(total.Percentile(50)));
+  output += ", \"p90_ns\": ";
+  AppendNumber(output, static_cast<double>(total.Percentile(90)));
+  output += ", \"p99_ns\": ";
+  AppendNumber(output, static_cast<double>(total.Percentile(99)));
+  output += ", \"p999_ns\": ";
+  AppendNumber(output, static_cast<double>(total.Percentile(99.9)));
+  output += ", \"max_ns\": ";
+  AppendNumber(output, static_cast<double>(total.max()));
+  output += "}";
+  AppendGroups(output, "by_length", kLengthGroups, by_length);
+  AppendGroups(output, "by_tokens", kTokenGroups, by_tokens);
+  output += "\n}\n";
+  return output;
+}
+
+static void PrintGroups(const char* title, const LatencyGroup* groups,
+                        const LatencyHistogram* histograms) {
+  std::printf("%-10s %10s %10s %10s %10s\n",
+              title, "count", "p50 ns", "p99 ns", "p99.9 ns");
+  for (size_t i = 0; i < kGroupCount; ++i) {
+    if (!histograms[i].count())
+      continue;
+    std::printf("%-10s %10llu %10llu %10llu %10llu\n", groups[i].range,
+                histograms[i].count(), histograms[i].Percentile(50),
+                histograms[i].Percentile(99), histograms[i].Percentile(99.9));
+  }
+}
+
+int BenchLatency(const BenchOptions& options) {
+  std::vector<string_t> filenames;
+  if (!LoadFilenames(options, filenames) || filenames.empty()) {
+    std::fprintf(stderr, "Cannot read %s\n", options.input.c_str());
+    return 1;
+  }
+
+  Anitomy anitomy;
+  anitomy.options().max_work = options.max_work;
+  anitomy.options().max_nanoseconds = options.max_nanoseconds;
+  anitomy.options().requested_categories = options.categories;
+
+  // Warm up, and find out which group each filename belongs to
+  std::vector<unsigned char> length_groups(filenames.size());
+  std::vector<unsigned char> token_groups(filenames.size());
+  for (size_t i = 0; i < filenames.size(); ++i) {
+    anitomy.Parse(filenames[i]);
+    length_groups[i] = static_cast<unsigned char>(
+        GetGroupIndex(kLengthGroups, filenames[i].size()));
+    token_groups[i] = static_cast<unsigned char>(
+        GetGroupIndex(kTokenGroups, anitomy.tokens().size()));
+  }
+
+  LatencyHistogram total;
+  LatencyHistogram by_length[kGroupCount];
+  LatencyHistogram by_tokens[kGroupCount];
+  std::vector<LatencyHistogram> runs(options.iterations);
+
+  for (size_t run = 0; run < runs.size(); ++run) {
+    for (size_t i = 0; i < filenames.size(); ++i) {
+      const unsigned long long start = GetStatsClock();
+      anitomy.Parse(filenames[i]);
+      const unsigned long long elapsed = GetStatsClock() - start;
+      runs[run].Record(elapsed);
+      by_length[length_groups[i]].Record(elapsed);
+      by_tokens[token_groups[i]].Record(elapsed);
+    }
+    total.Merge(runs[run]);
+  }
+
+  std::printf("%lu filenames, %lu runs\n",
+              static_cast<unsigned long>(filenames.size()),
+              static_cast<unsigned long>(runs.size()));
+  std::printf("mean %.1f ns, p50 %llu ns, p90 %llu ns, p99 %llu ns, "
+              "p99.9 %llu ns, max %llu ns\n\n",
+              total.mean(), total.Percentile(50), total.Percentile(90),
+              total.Percentile(99), total.Percentile(99.9), total.max());
+  PrintGroups("length", kLengthGroups, by_length);
+  std::printf("\n");
+  PrintGroups("tokens", kTokenGroups, by_tokens);
+
+  if (!options.output.empty()) {
+    FILE* file = std::fopen(options.output.c_str(), "wb");
+    if (!file) {
+      std::fprintf(stderr, "Cannot write %s\n", options.output.c_str());
+      return 1;
+    }
+    const std::string output =
+        FormatResults(filenames.size(), total, runs, by_length, by_tokens);
+    std::fwrite(output.data(), 1, output.size(), file);
+    std::fclose(file);
+  }
+
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Two-sided critical values of Student's t-distribution for p = 0.05, by
+// degrees of freedom
+static double GetCriticalValue(double degrees_of_freedom) {
+  static const double values[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+  };
+
+  // Rounding down is conservative
+  const size_t index = degrees_of_freedom < 1 ?
+      0 : static_cast<size_t>(degrees_of_freedom) - 1;
+  return index < _countof(values) ? values[index] : 1.96;
+}
+
+struct Sample {
+  Sample() : mean(0), variance(0), size(0) {}
+
+  double mean;
+  double variance;
+  size_t size;
+};
+
+static Sample GetSample(const JsonValue& results, const char* metric) {
+  Sample sample;
+  const JsonValue* runs = results.get("runs");
+  if (!runs)
+    return sample;
+
+  std::vector<double> values;
+  for (size_t i = 0; i < runs->array.size(); ++i)
+    values.push_back(runs->array[i].get_number(metric));
+
+  sample.size = values.size();
+  for (size_t i = 0; i < values.size(); ++i)
+    sample.mean += values[i];
+  if (sample.size)
+    sample.mean /= sample.size;
+  for (size_t i = 0; i < values.size(); ++i)
+    sample.variance += (values[i] - sample.mean) * (values[i] - sample.mean);
+  if (sample.size > 1)
+    sample.variance /= sample.size - 1;
+  return sample;
+}
+
+// Welch's t-test, which doesn't assume that both samples have the same
+// variance
+static bool IsSignificant(const Sample& a, const Sample& b) {
+  if (a.size < 2 || b.size < 2)
+    return false;
+  const double va = a.variance / a.size;
+  const double vb = b.variance / b.size;
+  if (va + vb <= 0)
+    return a.mean != b.mean;
+  const double t = std::fabs(a.mean - b.mean) / std::sqrt(va + vb);
+  const double df = (va + vb) * (va + vb) /
+      (va * va / (a.size - 1) + vb * vb / (b.size - 1));
+  return t > GetCriticalValue(df);
+}
+
+static double GetChange(double base, double current) {
+  return base > 0 ? (current - base) / base * 100.0 : 0;
+}
+
+static void PrintGroupChanges(const JsonValue& base, const JsonValue& current,
+                              const char* name) {
+  const JsonValue* base_groups = base.get(name);
+  const JsonValue* current_groups = current.get(name);
+  if (!base_groups || !current_groups)
+    return;
+
+  std::printf("\n%-10s %12s %12s %9s\n", name, "base p99", "p99", "change");
+  for (size_t i = 0; i < base_groups->array.size(); ++i) {
+    const JsonValue& base_group = base_groups->array[i];
+    for (size_t j = 0; j < current_groups->array.size(); ++j) {
+      const JsonValue& current_group = current_groups->array[j];
+      if (current_group.get_string("range") != base_group.get_string("range"))
+        continue;
+      if (!base_group.get_number("count") || !current_group.get_number("count"))
+        break;
+      const double base_p99 = base_group.get_number("p99_ns");
+      const double current_p99 = current_group.get_number("p99_ns");
+      std::printf("%-10s %12.1f %12.1f %+8.1f%%\n",
+                  base_group.get_string("range").c_str(), base_p99,
+                  current_p99, GetChange(base_p99, current_p99));
+      break;
+    }
+  }
+}
+
+int CompareResults(const std::string& base_path,
+                   const std::string& current_path,
+                   const BenchOptions& options) {
+  JsonValue base, current;
+  if (!LoadJson(base_path, base)) {
+    std::fprintf(stderr, "Cannot read %s\n", base_path.c_str());
+    return 1;
+  }
+  if (!LoadJson(current_path, current)) {
+    std::fprintf(stderr, "Cannot read %s\n", current_path.c_str());
+    return 1;
+  }
+
+  size_t regressions = 0;
+
+  std::printf("%-10s %12s %12s %9s\n", "metric", "base", "current", "change");
+  for (size_t i = 0; i < _countof(kRunMetrics); ++i) {
+    const Sample a = GetSample(base, kRunMetrics[i]);
+    const Sample b = GetSample(current, kRunMetrics[i]);
+    const double change = GetChange(a.mean, b.mean);
+    const char* verdict = "";
+    if (IsSignificant(a, b)) {
+      if (change > options.threshold) {
+        verdict = "  REGRESSION";
+        ++regressions;
+      } else if (change < -options.threshold) {
+        verdict = "  improvement";
+      }
+    }
+    std::printf("%-10s %12.1f %12.1f %+8.1f%%%s\n",
+                kRunMetrics[i], a.mean, b.mean, change, verdict);
+  }
+
+  // Groups are only recorded as a whole, so there is nothing to test them on
+  PrintGroupChanges(base, current, "by_length");
+  PrintGroupChanges(base, current, "by_tokens");
+
+  if (regressions)
+    std::printf("\n%lu significant regressions over %.1f%%\n",
+                static_cast<unsigned long>(regressions), options.threshold);
+  return regressions ? 1 : 0;
+}
+
+}  // namespace tools
+}  // namespace anitomy
\ No newline at end of file
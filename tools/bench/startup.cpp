@@ -0,0 +1,134 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Time to the first parse of a new process. Every run starts this program
+// again with the "first-parse" command, which parses a single filename and
+// reports the time since the exec, so that dynamic loading and static
+// initialization are included, but creating the process is not.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "../../anitomy/anitomy.h"
+#include "bench.h"
+#include "histogram.h"
+
+namespace anitomy {
+namespace tools {
+
+int FirstParse(const char* exec_clock) {
+  // Only counted if built with ANITOMY_ENABLE_STATS
+  const unsigned long long allocations =
+      GetAllocationCounters().allocations;
+
+  Anitomy anitomy;
+  anitomy.Parse(L"[TaigaSubs]_Toradora!_(2008)_-_01v2_-_Tiger_and_Dragon_"
+                L"[1280x720_H.264_FLAC][1234ABCD].mkv");
+
+  const unsigned long long elapsed =
+      GetStatsClock() - std::strtoull(exec_clock, NULL, 10);
+  std::printf("%llu %llu\n", elapsed, allocations);
+  return 0;
+}
+
+#ifdef _WIN32
+
+int BenchStartup(const BenchOptions& options, const char* program) {
+  std::fprintf(stderr, "startup is not supported on Windows\n");
+  return 1;
+}
+
+#else
+
+// Returns the output of one run, or an empty string if it failed
+static std::string RunFirstParse(const char* program) {
+  int fds[2];
+  if (pipe(fds) != 0)
+    return std::string();
+
+  const pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return std::string();
+  }
+  if (pid == 0) {
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[0]);
+    close(fds[1]);
+    char exec_clock[32];
+    std::snprintf(exec_clock, sizeof(exec_clock), "%llu", GetStatsClock());
+    execlp(program, program, "first-parse", exec_clock,
+           static_cast<char*>(NULL));
+    _exit(127);
+  }
+
+  close(fds[1]);
+  std::string output;
+  char buffer[64];
+  ssize_t size;
+  while ((size = read(fds[0], buffer, sizeof(buffer))) > 0)
+    output.append(buffer, size);
+  close(fds[0]);
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    return std::string();
+  return output;
+}
+
+int BenchStartup(const BenchOptions& options, const char* program) {
+  LatencyHistogram histogram;
+  unsigned long long allocations = 0;
+
+  for (size_t i = 0; i < options.processes; ++i) {
+    const std::string output = RunFirstParse(program);
+    unsigned long long elapsed = 0;
+    if (std::sscanf(output.c_str(), "%llu %llu", &elapsed, &allocations) !=
+        2) {
+      std::fprintf(stderr, "Cannot run %s first-parse\n", program);
+      return 1;
+    }
+    histogram.Record(elapsed);
+  }
+
+  std::printf("%lu processes, time to first parse: mean %.1f us, "
+              "p50 %.1f us, p90 %.1f us, p99 %.1f us\n",
+              static_cast<unsigned long>(histogram.count()),
+              histogram.mean() / 1000,
+              histogram.Percentile(50) / 1000.0,
+              histogram.Percentile(90) / 1000.0,
+              histogram.Percentile(99) / 1000.0);
+#if ANITOMY_ENABLE_STATS
+  std::printf("%llu allocations before main\n", allocations);
+#endif
+  return 0;
+}
+
+#endif  // _WIN32
+
+}  // namespace tools
+}  // namespace anitomy
\ No newline at end of file
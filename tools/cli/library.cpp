@@ -0,0 +1,183 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "library.h"
+
+namespace anitomy {
+namespace tools {
+
+Library::Library(const std::string& root)
+    : root_(root) {
+  while (root_.size() > 1 && root_[root_.size() - 1] == '/')
+    root_.resize(root_.size() - 1);
+}
+
+const std::string& Library::root() const {
+  return root_;
+}
+
+size_t Library::size() const {
+  return entries_.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Library::Scan(std::vector<Delta>& deltas) {
+  ScanDirectory(root_, deltas);
+}
+
+void Library::Rescan(std::vector<Delta>& deltas) {
+  Update(std::set<std::string>(&root_, &root_ + 1), deltas);
+}
+
+void Library::Update(const std::set<std::string>& paths,
+                     std::vector<Delta>& deltas) {
+  for (std::set<std::string>::const_iterator path = paths.begin(); path != paths.end(); ++path) {
+    struct stat st;
+    if (lstat(path->c_str(), &st) != 0) {
+      RemovePath(*path, deltas);
+    } else if (S_ISDIR(st.st_mode)) {
+      // Files that have disappeared while we weren't watching
+      std::set<std::string> visited;
+      ScanDirectory(*path, deltas, &visited);
+      RemoveStaleEntries(*path, visited, deltas);
+    } else if (S_ISREG(st.st_mode)) {
+      UpdateFile(*path, deltas);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Library::ScanDirectory(const std::string& path,
+                            std::vector<Delta>& deltas,
+                            std::set<std::string>* visited) {
+  DIR* dir = opendir(path.c_str());
+  if (!dir)
+    return;
+
+  while (struct dirent* entry = readdir(dir)) {
+    const std::string name = entry->d_name;
+    if (name == "." || name == "..")
+      continue;
+
+    const std::string child = path + "/" + name;
+    struct stat st;
+    if (lstat(child.c_str(), &st) != 0)
+      continue;
+
+    if (S_ISDIR(st.st_mode)) {
+      ScanDirectory(child, deltas, visited);
+    } else if (S_ISREG(st.st_mode)) {
+      UpdateFile(child, deltas);
+      if (visited)
+        visited->insert(child);
+    }
+  }
+
+  closedir(dir);
+}
+
+void Library::UpdateFile(const std::string& path, std::vector<Delta>& deltas) {
+  const size_t position = path.find_last_of('/');
+  const std::string name =
+      position == std::string::npos ? path : path.substr(position + 1);
+
+  const bool parsed = anitomy_.Parse(Utf8ToString(name));
+  entry_container_t::iterator entry = entries_.find(path);
+
+  if (!parsed) {
+    if (entry != entries_.end())
+      RemovePath(path, deltas);
+    return;
+  }
+
+  Delta delta;
+  delta.path = path;
+  delta.elements = anitomy_.elements();
+
+  if (entry == entries_.end()) {
+    delta.kind = kDeltaAdded;
+    entries_.insert(std::make_pair(path, anitomy_.elements()));
+  } else if (!IsElementsEqual(entry->second, anitomy_.elements())) {
+    delta.kind = kDeltaUpdated;
+    entry->second = anitomy_.elements();
+  } else {
+    return;  // Touched, but nothing has changed
+  }
+
+  deltas.push_back(delta);
+}
+
+void Library::RemovePath(const std::string& path, std::vector<Delta>& deltas) {
+  // The path is either a file, or a directory that may contain many files
+  const std::string prefix = path + "/";
+
+  entry_container_t::iterator entry = entries_.find(path);
+  if (entry == entries_.end())
+    entry = entries_.lower_bound(prefix);
+
+  while (entry != entries_.end() &&
+         (entry->first == path ||
+          entry->first.compare(0, prefix.size(), prefix) == 0)) {
+    Delta delta;
+    delta.kind = kDeltaRemoved;
+    delta.path = entry->first;
+    deltas.push_back(delta);
+    entries_.erase(entry++);
+  }
+}
+
+void Library::RemoveStaleEntries(const std::string& path,
+                                 const std::set<std::string>& visited,
+                                 std::vector<Delta>& deltas) {
+  const std::string prefix = path + "/";
+
+  entry_container_t::iterator entry = entries_.lower_bound(prefix);
+  while (entry != entries_.end() &&
+         entry->first.compare(0, prefix.size(), prefix) == 0) {
+    if (visited.find(entry->first) == visited.end()) {
+      Delta delta;
+      delta.kind = kDeltaRemoved;
+      delta.path = entry->first;
+      deltas.push_back(delta);
+      entries_.erase(entry++);
+    } else {
+      ++entry;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool IsElementsEqual(const Elements& elements1, const Elements& elements2) {
+  if (elements1.size() != elements2.size())
+    return false;
+
+  for (size_t i = 0; i < elements1.size(); ++i)
+    if (elements1[i] != elements2[i])
+      return false;
+
+  return true;
+}
+
+}  // namespace tools
+}  // namespace anitomy
\ No newline at end of file
@@ -0,0 +1,83 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_LIBRARY_H
+#define ANITOMY_TOOLS_LIBRARY_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/anitomy.h"
+
+namespace anitomy {
+namespace tools {
+
+enum DeltaKind {
+  kDeltaAdded,
+  kDeltaUpdated,
+  kDeltaRemoved
+};
+
+struct Delta {
+  DeltaKind kind;
+  std::string path;
+  Elements elements;
+};
+
+// Keeps the parse results of every file under a root directory. Paths are
+// stored as raw bytes, only the file name component is handed to Anitomy.
+class Library {
+public:
+  explicit Library(const std::string& root);
+
+  const std::string& root() const;
+  size_t size() const;
+
+  // Walks the whole tree, reporting every file as added
+  void Scan(std::vector<Delta>& deltas);
+  // Walks the whole tree again, reporting only what has changed
+  void Rescan(std::vector<Delta>& deltas);
+
+  // Re-examines the given paths only. A path may be a file or a directory
+  // that has been created, renamed or removed since the last call.
+  void Update(const std::set<std::string>& paths, std::vector<Delta>& deltas);
+
+private:
+  void ScanDirectory(const std::string& path, std::vector<Delta>& deltas,
+                     std::set<std::string>* visited = NULL);
+  void UpdateFile(const std::string& path, std::vector<Delta>& deltas);
+  void RemovePath(const std::string& path, std::vector<Delta>& deltas);
+  void RemoveStaleEntries(const std::string& path,
+                          const std::set<std::string>& visited,
+                          std::vector<Delta>& deltas);
+
+  typedef std::map<std::string, Elements> entry_container_t;
+
+  Anitomy anitomy_;
+  entry_container_t entries_;
+  std::string root_;
+};
+
+bool IsElementsEqual(const Elements& elements1, const Elements& elements2);
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_LIBRARY_H
\ No newline at end of file
@@ -0,0 +1,152 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/anitomy.h"
+#include "../common/element_name.h"
+#include "library.h"
+#include "watcher.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+static void PrintElements(const Elements& elements) {
+  for (element_const_iterator_t element = elements.begin(); element != elements.end(); ++element) {
+    std::printf("\t%s=%s", ElementCategoryName(element->first),
+                StringToUtf8(element->second).c_str());
+  }
+}
+
+static void PrintDeltas(const std::vector<Delta>& deltas) {
+  for (std::vector<Delta>::const_iterator delta = deltas.begin(); delta != deltas.end(); ++delta) {
+    static const char kinds[] = {'+', '~', '-'};
+    std::printf("%c\t%s", kinds[delta->kind], delta->path.c_str());
+    PrintElements(delta->elements);
+    std::printf("\n");
+  }
+  std::fflush(stdout);
+}
+
+static void PrintStats(const ParseStats& stats) {
+  std::printf("\tallocations=%llu\tallocated_bytes=%llu\tpeak_live_bytes=%llu",
+              stats.allocations[kParseStageTotal],
+              stats.allocated_bytes[kParseStageTotal],
+              stats.peak_live_bytes);
+}
+
+static int PrintUsage() {
+  std::fprintf(stderr,
+      "Usage: anitomy [--stats] <filename>...\n"
+      "       anitomy --scan <root>\n"
+      "       anitomy --watch <root>\n"
+      "\n"
+      "Results are printed one per line, as tab-separated key=value pairs.\n"
+      "In --scan and --watch modes each line starts with a delta:\n"
+      "  +  added    ~  updated    -  removed\n"
+      "\n"
+      "--stats appends the allocations made by each parse, and prints a\n"
+      "total to stderr. It requires a build with -DANITOMY_ENABLE_STATS=1.\n");
+  return 1;
+}
+
+static int ParseFilenames(int argc, char* argv[], int first, bool stats) {
+  Anitomy anitomy;
+
+  for (int i = first; i < argc; ++i) {
+    std::printf("%s", argv[i]);
+    if (anitomy.Parse(Utf8ToString(argv[i])))
+      PrintElements(anitomy.elements());
+    if (stats)
+      PrintStats(anitomy.stats());
+    std::printf("\n");
+  }
+
+  if (stats) {
+    const ParseStats& total = anitomy.total_stats();
+    std::fprintf(stderr, "%llu parses, %llu allocations, %llu bytes "
+                 "allocated, %llu peak live bytes\n", total.parses,
+                 total.allocations[kParseStageTotal],
+                 total.allocated_bytes[kParseStageTotal],
+                 total.peak_live_bytes);
+  }
+
+  return 0;
+}
+
+static int ScanLibrary(const char* root, bool watch) {
+  Library library(root);
+  Watcher watcher;
+
+  // Start watching before the initial scan, so that nothing that arrives in
+  // the meantime is missed.
+  if (watch && !watcher.Open(library.root())) {
+    std::fprintf(stderr, "Cannot watch %s\n", root);
+    return 1;
+  }
+
+  std::vector<Delta> deltas;
+  library.Scan(deltas);
+  PrintDeltas(deltas);
+
+  while (watch) {
+    std::set<std::string> paths;
+    bool rescan = false;
+    if (!watcher.Wait(paths, rescan)) {
+      if (watcher.root_gone())
+        std::fprintf(stderr, "%s was removed or moved\n", root);
+      return 1;
+    }
+
+    deltas.clear();
+    if (rescan) {
+      library.Rescan(deltas);
+    } else {
+      library.Update(paths, deltas);
+    }
+    PrintDeltas(deltas);
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2)
+    return PrintUsage();
+
+  if (std::strcmp(argv[1], "--scan") == 0 ||
+      std::strcmp(argv[1], "--watch") == 0) {
+    if (argc != 3)
+      return PrintUsage();
+    return ScanLibrary(argv[2], std::strcmp(argv[1], "--watch") == 0);
+  }
+
+  if (std::strcmp(argv[1], "--stats") == 0) {
+#if !ANITOMY_ENABLE_STATS
+    std::fprintf(stderr, "--stats requires a build with "
+                 "-DANITOMY_ENABLE_STATS=1\n");
+    return 1;
+#endif
+    return ParseFilenames(argc, argv, 2, true);
+  }
+
+  return ParseFilenames(argc, argv, 1, false);
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "watcher.h"
+
+namespace anitomy {
+namespace tools {
+
+static const unsigned int kWatchMask =
+    IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+// Subdirectories that go away are reported by their parent, but the root has
+// to report itself
+static const unsigned int kRootWatchMask =
+    kWatchMask | IN_DELETE_SELF | IN_MOVE_SELF;
+
+static long MonotonicMilliseconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+Watcher::Watcher()
+    : fd_(-1), root_wd_(-1), root_gone_(false) {
+}
+
+Watcher::~Watcher() {
+  if (fd_ != -1)
+    close(fd_);
+}
+
+bool Watcher::Open(const std::string& root) {
+  fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd_ == -1)
+    return false;
+
+  root_ = root;
+  AddWatches(root);
+
+  return !watches_.empty();
+}
+
+bool Watcher::root_gone() const {
+  return root_gone_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Watcher::Wait(std::set<std::string>& paths, bool& rescan,
+                   int quiet_ms, int max_delay_ms) {
+  struct pollfd pfd;
+  pfd.fd = fd_;
+  pfd.events = POLLIN;
+
+  // Block until something happens
+  while (paths.empty() && !rescan && !root_gone_) {
+    if (poll(&pfd, 1, -1) == -1)
+      return false;
+    if (!ReadEvents(paths, rescan))
+      return false;
+  }
+
+  // Coalesce the rest of the burst
+  const long first_event = MonotonicMilliseconds();
+  for (;;) {
+    const long remaining = max_delay_ms - (MonotonicMilliseconds() - first_event);
+    if (remaining <= 0)
+      break;
+    const int timeout = static_cast<int>(remaining < quiet_ms ? remaining : quiet_ms);
+    const int result = poll(&pfd, 1, timeout);
+    if (result == -1)
+      return false;
+    if (result == 0)
+      break;  // Quiet for long enough
+    if (!ReadEvents(paths, rescan))
+      return false;
+  }
+
+  if (root_gone_)
+    return false;
+  if (rescan)
+    RebuildWatches();
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Watcher::AddWatches(const std::string& path) {
+  const bool root = path == root_;
+  const int wd = inotify_add_watch(fd_, path.c_str(),
+                                   root ? kRootWatchMask : kWatchMask);
+  if (wd == -1)
+    return;
+  watches_[wd] = path;
+  if (root)
+    root_wd_ = wd;
+
+  DIR* dir = opendir(path.c_str());
+  if (!dir)
+    return;
+
+  while (struct dirent* entry = readdir(dir)) {
+    const std::string name = entry->d_name;
+    if (name == "." || name == "..")
+      continue;
+    const std::string child = path + "/" + name;
+    struct stat st;
+    if (lstat(child.c_str(), &st) == 0 && S_ISDIR(st.st_mode))
+      AddWatches(child);
+  }
+
+  closedir(dir);
+}
+
+void Watcher::RemoveWatches(const std::string& path) {
+  const std::string prefix = path + "/";
+
+  std::map<int, std::string>::iterator watch = watches_.begin();
+  while (watch != watches_.end()) {
+    if (watch->second == path ||
+        watch->second.compare(0, prefix.size(), prefix) == 0) {
+      inotify_rm_watch(fd_, watch->first);
+      watches_.erase(watch++);
+    } else {
+      ++watch;
+    }
+  }
+}
+
+// Events were dropped, so the watches may be missing directories that were
+// created or moved in meanwhile, and may still name directories that were
+// moved elsewhere. Dropping every watch and walking the tree again fixes
+// both. Events of the old watches that are still queued are ignored, since
+// their descriptors are no longer known.
+void Watcher::RebuildWatches() {
+  for (std::map<int, std::string>::const_iterator watch = watches_.begin(); watch != watches_.end(); ++watch)
+    inotify_rm_watch(fd_, watch->first);
+  watches_.clear();
+  root_wd_ = -1;
+
+  AddWatches(root_);
+  if (root_wd_ == -1)
+    root_gone_ = true;
+}
+
+bool Watcher::ReadEvents(std::set<std::string>& paths, bool& rescan) {
+  // Large enough for a few hundred events at once
+  char buffer[64 * 1024]
+      __attribute__((aligned(__alignof__(struct inotify_event))));
+
+  for (;;) {
+    const ssize_t length = read(fd_, buffer, sizeof(buffer));
+    if (length == -1)
+      return errno == EAGAIN || errno == EINTR;
+    if (length == 0)
+      return true;
+
+    for (char* ptr = buffer; ptr < buffer + length; ) {
+      const struct inotify_event* event =
+          reinterpret_cast<const struct inotify_event*>(ptr);
+      ptr += sizeof(struct inotify_event) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        rescan = true;
+        continue;
+      }
+      if (event->wd == root_wd_ &&
+          (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT |
+                          IN_IGNORED))) {
+        root_gone_ = true;
+        continue;
+      }
+      if (event->mask & IN_IGNORED) {
+        watches_.erase(event->wd);
+        continue;
+      }
+
+      std::map<int, std::string>::const_iterator watch = watches_.find(event->wd);
+      if (watch == watches_.end() || event->len == 0)
+        continue;
+
+      const std::string path = watch->second + "/" + event->name;
+      paths.insert(path);
+
+      if (event->mask & IN_ISDIR) {
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+          AddWatches(path);
+        } else if (event->mask & IN_MOVED_FROM) {
+          RemoveWatches(path);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace tools
+}  // namespace anitomy
\ No newline at end of file
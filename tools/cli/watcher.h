@@ -0,0 +1,70 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_WATCHER_H
+#define ANITOMY_TOOLS_WATCHER_H
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace anitomy {
+namespace tools {
+
+// Tracks a directory tree with inotify. Events are collected into a set of
+// changed paths; a burst of events (e.g. a batch release moving dozens of
+// episodes into place) is coalesced into a single set.
+class Watcher {
+public:
+  Watcher();
+  ~Watcher();
+
+  bool Open(const std::string& root);
+
+  // Blocks until at least one change is available, then keeps reading until
+  // the tree has been quiet for `quiet_ms`, or `max_delay_ms` has passed since
+  // the first event. Returns false on error, or if the root is gone (see
+  // root_gone). If the kernel queue overflows, the watches are rebuilt from
+  // the root, since directories may have come and gone unseen, and `rescan`
+  // is set: the caller should then scan the whole tree again.
+  bool Wait(std::set<std::string>& paths, bool& rescan,
+            int quiet_ms = 20, int max_delay_ms = 250);
+
+  // Whether the root was deleted, moved or unmounted
+  bool root_gone() const;
+
+private:
+  Watcher(const Watcher&);
+  Watcher& operator=(const Watcher&);
+
+  void AddWatches(const std::string& path);
+  void RemoveWatches(const std::string& path);
+  void RebuildWatches();
+  bool ReadEvents(std::set<std::string>& paths, bool& rescan);
+
+  int fd_;
+  std::string root_;
+  int root_wd_;
+  bool root_gone_;
+  std::map<int, std::string> watches_;
+};
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_WATCHER_H
\ No newline at end of file
@@ -0,0 +1,58 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_ARGUMENTS_H
+#define ANITOMY_TOOLS_ARGUMENTS_H
+
+#include <errno.h>
+
+#include <cstdlib>
+
+namespace anitomy {
+namespace tools {
+
+// Reads a decimal number no larger than `max` from a command-line argument.
+// Unlike atoi, rejects signs, trailing characters and values that do not
+// fit. `max` must fit in T.
+template <class T>
+bool ParseNumber(const char* text, unsigned long long max, T& value) {
+  if (*text < '0' || *text > '9')
+    return false;
+  char* end = NULL;
+  errno = 0;
+  const unsigned long long result = std::strtoull(text, &end, 10);
+  if (*end != '\0' || errno == ERANGE || result > max)
+    return false;
+  value = static_cast<T>(result);
+  return true;
+}
+
+// Same as ParseNumber, but for things that there must be at least one of
+template <class T>
+bool ParseCount(const char* text, unsigned long long max, T& value) {
+  T result;
+  if (!ParseNumber(text, max, result) || result == 0)
+    return false;
+  value = result;
+  return true;
+}
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_ARGUMENTS_H
\ No newline at end of file
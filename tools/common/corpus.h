@@ -0,0 +1,522 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_CORPUS_H
+#define ANITOMY_TOOLS_CORPUS_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/keyword.h"
+#include "../../anitomy/string.h"
+
+namespace anitomy {
+namespace tools {
+
+// Generates synthetic filenames. The output depends only on the seed, and
+// doesn't change between platforms.
+//
+// GenerateLibrary() produces a simple library: a number of series, each
+// released by one group with the same set of tags on every episode.
+//
+// Generate() and NextFilename() produce the standard corpus, which is the
+// input of the throughput benchmarks. Series are built from the release
+// groups, titles, episode forms, bracket styles and delimiters seen in
+// test/data.json, and tagged with the keywords of KeywordManager. A small
+// share of adversarial filenames (very long, deeply nested or unbalanced
+// brackets, number and keyword soups) is mixed in. Optionally, some series
+// have titles in other scripts than Latin (see set_mixed_script_rate).
+class CorpusGenerator {
+public:
+  explicit CorpusGenerator(unsigned int seed)
+      : state_(seed), adversarial_rate_(2), mixed_script_rate_(0),
+        keywords_loaded_(false) {
+    series_.episode = series_.last_episode = 0;
+  }
+
+  // Percentage of adversarial filenames in the standard corpus
+  void set_adversarial_rate(unsigned int percent) {
+    adversarial_rate_ = percent;
+  }
+
+  // Percentage of series in the standard corpus with titles in Japanese,
+  // Cyrillic, Greek, accented Latin or fullwidth forms. The corpus is the
+  // same as before if it is 0.
+  void set_mixed_script_rate(unsigned int percent) {
+    mixed_script_rate_ = percent;
+  }
+
+  void GenerateLibrary(size_t series_count, size_t episode_count,
+                       std::vector<string_t>& filenames) {
+    static const char* const groups[] = {
+      "HorribleSubs", "Commie", "FFF", "gg", "Underwater", "Coalgirls", "Doki",
+      "UTW", "Vivid", "Chihiro", "THORA", "Kametsu", "Erai-raws", "SubsPlease",
+    };
+    static const char* const resolutions[] = {
+      "480p", "720p", "1080p", "1280x720", "1920x1080",
+    };
+    static const char* const sources[] = {
+      "BD", "BDRip", "Blu-ray", "DVD", "TV", "WEB",
+    };
+    static const char* const video_terms[] = {
+      "H.264", "x264", "HEVC", "x265", "Hi10P", "10bit", "AVC",
+    };
+    static const char* const audio_terms[] = {
+      "AAC", "FLAC", "AC3", "Dual Audio", "DTS",
+    };
+    static const char* const extensions[] = {
+      "mkv", "mp4", "avi",
+    };
+
+    for (size_t i = 0; i < series_count; ++i) {
+      const std::string title = GenerateTitle();
+      const std::string group = Pick(groups, _countof(groups));
+      const std::string resolution = Pick(resolutions, _countof(resolutions));
+      const std::string source = Pick(sources, _countof(sources));
+      const std::string video = Pick(video_terms, _countof(video_terms));
+      const std::string audio = Pick(audio_terms, _countof(audio_terms));
+      const std::string extension = Pick(extensions, _countof(extensions));
+      const unsigned int style = Next() % 3;
+
+      for (size_t episode = 1; episode <= episode_count; ++episode) {
+        char number[16];
+        std::snprintf(number, sizeof(number), "%02u",
+                      static_cast<unsigned int>(episode));
+        std::string filename;
+        switch (style) {
+          case 0:
+            filename = "[" + group + "] " + title + " - " + number + " [" +
+                       resolution + "]." + extension;
+            break;
+          case 1:
+            filename = "[" + group + "] " + title + " - " + number + " (" +
+                       source + " " + resolution + " " + video + " " + audio +
+                       ") [" + GenerateChecksum() + "]." + extension;
+            break;
+          default:
+            filename = Dotted(title) + ".E" + number + "." + resolution +
+                       "." + source + "." + video + "-" + group + "." +
+                       extension;
+            break;
+        }
+        filenames.push_back(Utf8ToString(filename));
+      }
+    }
+  }
+
+  void Generate(size_t count, std::vector<string_t>& filenames) {
+    filenames.reserve(filenames.size() + count);
+    for (size_t i = 0; i < count; ++i)
+      filenames.push_back(Utf8ToString(NextFilename()));
+  }
+
+  // Returns the next filename of the standard corpus in UTF-8, so that large
+  // corpora can be streamed instead of held in memory
+  std::string NextFilename() {
+    LoadKeywords();
+    if (Next() % 100 < adversarial_rate_)
+      return GenerateAdversarial();
+    if (series_.episode >= series_.last_episode)
+      StartSeries();
+    return FormatEpisode(++series_.episode);
+  }
+
+private:
+  struct Series {
+    std::string group;
+    std::string title;
+    std::string tags;
+    std::string type;
+    std::string checksum_open;
+    std::string checksum_close;
+    std::string extension;
+    char delimiter;
+    unsigned int layout;
+    unsigned int episode_form;
+    unsigned int episode;
+    unsigned int last_episode;
+    unsigned int version;
+  };
+
+  unsigned int Next() {
+    // Numerical Recipes LCG; rand() differs between platforms
+    state_ = state_ * 1664525U + 1013904223U;
+    return state_ >> 8;
+  }
+
+  std::string Pick(const char* const* values, size_t count) {
+    return values[Next() % count];
+  }
+
+  const std::string& Pick(const std::vector<std::string>& values) {
+    return values[Next() % values.size()];
+  }
+
+  void LoadKeywords() {
+    if (keywords_loaded_)
+      return;
+    keywords_loaded_ = true;
+
+    static const ElementCategory categories[] = {
+      kElementAudioTerm, kElementDeviceCompatibility, kElementLanguage,
+      kElementOther, kElementReleaseInformation, kElementSource,
+      kElementSubtitles, kElementVideoTerm,
+    };
+    std::vector<string_t> keywords;
+    for (size_t i = 0; i < _countof(categories); ++i)
+      keyword_manager.GetKeywords(categories[i], keywords);
+    for (size_t i = 0; i < keywords.size(); ++i)
+      tag_keywords_.push_back(StringToUtf8(keywords[i]));
+
+    keywords.clear();
+    keyword_manager.GetKeywords(kElementFileExtension, keywords);
+    for (size_t i = 0; i < keywords.size(); ++i)
+      extension_keywords_.push_back(StringToUtf8(keywords[i]));
+
+    keywords.clear();
+    keyword_manager.GetKeywords(kElementAnimeType, keywords);
+    for (size_t i = 0; i < keywords.size(); ++i)
+      type_keywords_.push_back(StringToUtf8(keywords[i]));
+  }
+
+  // Keywords are stored in upper case; real filenames use every variant
+  std::string VaryCase(std::string keyword) {
+    switch (Next() % 3) {
+      case 0:
+        break;
+      case 1:
+        for (size_t i = 0; i < keyword.size(); ++i)
+          if (keyword[i] >= 'A' && keyword[i] <= 'Z')
+            keyword[i] = keyword[i] - 'A' + 'a';
+        break;
+      default:
+        for (size_t i = 1; i < keyword.size(); ++i)
+          if (keyword[i] >= 'A' && keyword[i] <= 'Z')
+            keyword[i] = keyword[i] - 'A' + 'a';
+        break;
+    }
+    return keyword;
+  }
+
+  std::string GenerateTitle() {
+    static const char* const words[] = {
+      "Akai", "Aoi", "Sora", "Hoshi", "Kaze", "Yume", "Tsuki", "Hikari",
+      "Kokoro", "Sekai", "Mirai", "Densetsu", "Monogatari", "Shoujo", "Senki",
+      "Gakuen", "Kimi", "Boku", "Yoru", "Natsu", "Fuyu", "Sakura", "Tenshi",
+      "Majo", "Shinigami", "Ou", "Kishi", "no", "to", "wa",
+    };
+
+    std::string title;
+    const unsigned int word_count = 1 + Next() % 4;
+    for (unsigned int i = 0; i < word_count; ++i) {
+      if (i > 0)
+        title += ' ';
+      title += Pick(words, _countof(words));
+    }
+    return title;
+  }
+
+  // Titles from the test data that contain numbers, punctuation or keywords
+  std::string GenerateStandardTitle() {
+    static const char* const titles[] = {
+      "Toradora!", "Steins;Gate", "Fullmetal Alchemist Brotherhood",
+      "Mobile Suit Gundam 00", "Evangelion 1.11 You Are (Not) Alone",
+      "Kuroko no Basuke S3", "Tokyo ESP", "Bokura ga Ita", "Fairy Tail 2",
+      "Yumeiro Patissiere SP Professional", "The End of Evangelion",
+      "Final Approach", "5 centimeters per second", "Tiger & Bunny",
+      "Gift ~eternal rainbow~", "Hayate no Gotoku 2nd Season", "Canaan",
+      "Princess Lover!", "Red Data Girl", "Dragon Ball Kai", "Black Bullet",
+      "Seikon no Qwaser", "Spice and Wolf", "Noein", "Byousoku 5 Centimeter",
+    };
+
+    if (Next() % 4 == 0)
+      return Pick(titles, _countof(titles));
+    return GenerateTitle();
+  }
+
+  // In UTF-8
+  std::string GenerateMixedScriptTitle() {
+    static const char* const titles[] = {
+      "\xE9\x80\xB2\xE6\x92\x83\xE3\x81\xAE\xE5\xB7\xA8\xE4\xBA\xBA",
+      "\xD0\xA2\xD0\xB5\xD1\x82\xD1\x80\xD0\xB0\xD0\xB4\xD1\x8C "
+      "\xD1\x81\xD0\xBC\xD0\xB5\xD1\x80\xD1\x82\xD0\xB8",
+      "Pok\xC3\xA9mon \xC3\x89volution",
+      "\xEF\xBC\xA6\xEF\xBC\xB5\xEF\xBC\xAC\xEF\xBC\xAC\xEF\xBC\xAD"
+      "\xEF\xBC\xA5\xEF\xBC\xB4\xEF\xBC\xA1\xEF\xBC\xAC "
+      "\xEF\xBC\xB0\xEF\xBC\xA1\xEF\xBC\xAE\xEF\xBC\xA9\xEF\xBC\xA3",
+      "M\xC3\xA4" "dchen M\xC3\xA4rchen",
+      "\xCE\xA8\xCF\x85\xCF\x87\xCE\xAE "
+      "\xCE\x9A\xCF\x8C\xCF\x83\xCE\xBC\xCE\xBF\xCF\x82",
+      "\xD0\x81\xD0\xB6\xD0\xB8\xD0\xBA \xD0\xB2 "
+      "\xD1\x82\xD1\x83\xD0\xBC\xD0\xB0\xD0\xBD\xD0\xB5",
+      "\xC5\x81\xC3\xB3" "d\xC5\xBA \xC5\x9A" "cie\xC5\xBCka",
+      "\xC3\x87" "a\xC4\x9F \xC3\x96yk\xC3\xBC",
+      "\xEF\xBC\xAB\xEF\xBC\x8D\xEF\xBC\xAF\xEF\xBC\xAE\xEF\xBC\x81",
+      "\xD0\xA1\xD0\xB0\xD0\xBA\xD1\x83\xD1\x80\xD0\xB0 "
+      "\xCE\xA3\xCF\x86\xCE\xB1\xCE\xAF\xCF\x81\xCE\xB1",
+      "R\xC3\xA9z \xC3\x81ngyal",
+    };
+
+    return Pick(titles, _countof(titles));
+  }
+
+  std::string GenerateChecksum() {
+    const unsigned int high = Next();
+    const unsigned int low = Next();
+    char checksum[16];
+    std::snprintf(checksum, sizeof(checksum), "%08X", (high << 8) ^ low);
+    return checksum;
+  }
+
+  std::string GenerateTags(const std::string& separator) {
+    static const char* const resolutions[] = {
+      "480p", "720p", "1080p", "1280x720", "1920x1080", "1024x576",
+      "848x480", "1904x1072",
+    };
+
+    std::string tags = Pick(resolutions, _countof(resolutions));
+    const unsigned int count = Next() % 6;
+    for (unsigned int i = 0; i < count; ++i)
+      tags += separator + VaryCase(Pick(tag_keywords_));
+    return tags;
+  }
+
+  void StartSeries() {
+    static const char* const groups[] = {
+      "HorribleSubs", "Commie", "FFF", "gg", "Underwater", "Coalgirls",
+      "Doki", "UTW", "Vivid", "Chihiro", "THORA", "Kametsu", "Erai-raws",
+      "TaigaSubs", "Ouroboros", "ANBU-Menclave", "chibi-Doki", "Hatsuyuki",
+      "ElfFansubs", "Conclave-Mendoi", "AKH-SWE", "Kira-Fansub", "NinjaPanda",
+      "Hakugetsu&Speed&MGRT", "Hatsuyuki-Kaitou", "niizk", "Rakuda",
+    };
+    static const char* const separators[] = {
+      " ", ",", "_", ".",
+    };
+    static const char* const extensions[] = {
+      "mkv", "mkv", "mkv", "mp4", "avi",
+    };
+
+    Series& series = series_;
+    series.group = Pick(groups, _countof(groups));
+    if (mixed_script_rate_ && Next() % 100 < mixed_script_rate_)
+      series.title = GenerateMixedScriptTitle();
+    else
+      series.title = GenerateStandardTitle();
+    series.layout = Next() % 6;
+    series.delimiter = series.layout == 2 ? '.' : (Next() % 3 ? ' ' : '_');
+    series.tags = GenerateTags(Pick(separators, _countof(separators)));
+    series.type = VaryCase(Pick(type_keywords_));
+    series.episode_form = Next() % 10;
+    series.episode = Next() % 8 ? 0 : Next() % 100;
+    series.last_episode = series.episode + 1 + Next() % 26;
+    series.version = Next() % 8 == 0 ? 2 + Next() % 2 : 0;
+    series.checksum_open = Next() % 2 ? "[" : "(";
+    series.checksum_close = series.checksum_open == "[" ? "]" : ")";
+    if (Next() % 8 == 0)
+      series.extension = VaryCase(Pick(extension_keywords_));
+    else
+      series.extension = Pick(extensions, _countof(extensions));
+
+    if (series.delimiter != ' ')
+      for (size_t i = 0; i < series.title.size(); ++i)
+        if (series.title[i] == ' ')
+          series.title[i] = series.delimiter;
+  }
+
+  std::string FormatEpisodeNumber(unsigned int episode) {
+    const Series& series = series_;
+    char number[64];
+    switch (series.episode_form) {
+      case 0:
+      case 1:
+        std::snprintf(number, sizeof(number), "%02u", episode);
+        break;
+      case 2:
+        std::snprintf(number, sizeof(number), "E%02u", episode);
+        break;
+      case 3:
+        std::snprintf(number, sizeof(number), "Ep%02u", episode);
+        break;
+      case 4:
+        std::snprintf(number, sizeof(number), "Episode %u", episode);
+        break;
+      case 5:
+        std::snprintf(number, sizeof(number), "S%02uE%02u",
+                      1 + episode / 13, episode);
+        break;
+      case 6:
+        std::snprintf(number, sizeof(number), "%02u-%02u", episode,
+                      episode + 1);
+        break;
+      case 7:
+        std::snprintf(number, sizeof(number), "#%02u", episode);
+        break;
+      case 8:
+        std::snprintf(number, sizeof(number), "%03u (%u)", episode,
+                      episode + 100);
+        break;
+      default:
+        std::snprintf(number, sizeof(number), "\xE7\xAC\xAC%02u\xE8\xA9\xB1",
+                      episode);  // Japanese counter
+        break;
+    }
+
+    std::string result = number;
+    if (series.version) {
+      std::snprintf(number, sizeof(number), "v%u", series.version);
+      result += number;
+    }
+    return result;
+  }
+
+  std::string FormatEpisode(unsigned int episode) {
+    const Series& series = series_;
+    const std::string number = FormatEpisodeNumber(episode);
+    const std::string delimiter(1, series.delimiter);
+    const std::string dash = delimiter + "-" + delimiter;
+
+    std::string filename;
+    switch (series.layout) {
+      case 0:
+        filename = "[" + series.group + "]" + delimiter + series.title +
+                   dash + number + delimiter + "[" + series.tags + "]" +
+                   series.checksum_open + GenerateChecksum() +
+                   series.checksum_close;
+        break;
+      case 1:
+        filename = "[" + series.group + "]" + delimiter + series.title +
+                   dash + number + delimiter + "(" + series.tags + ")" +
+                   delimiter + series.checksum_open + GenerateChecksum() +
+                   series.checksum_close;
+        break;
+      case 2:
+        filename = series.title + "." + number + "." + series.tags + "-" +
+                   series.group;
+        break;
+      case 3:
+        filename = series.title + delimiter + number + delimiter + "[" +
+                   series.tags + "]" + dash + series.group;
+        break;
+      case 4: {
+        char of[32];
+        std::snprintf(of, sizeof(of), "[%02u of %u]", episode,
+                      series.last_episode);
+        filename = series.title + delimiter + of + delimiter + "[" +
+                   series.group + "]";
+        break;
+      }
+      default:
+        filename = "[" + series.group + "]" + delimiter + series.title +
+                   delimiter + "(" + series.type + ")" +
+                   dash + number + dash + GenerateTitle() + delimiter + "[" +
+                   series.tags + "]";
+        break;
+    }
+
+    return filename + "." + series.extension;
+  }
+
+  std::string GenerateAdversarial() {
+    static const char* const openers[] = {
+      "[", "(", "{", "\xE3\x80\x8C", "\xE3\x80\x8E", "\xE3\x80\x90",
+    };
+    static const char* const closers[] = {
+      "]", ")", "}", "\xE3\x80\x8D", "\xE3\x80\x8F", "\xE3\x80\x91",
+    };
+    static const char* const delimiters[] = {
+      " ", "_", ".", "-", "&", "+", ",", "|",
+    };
+
+    std::string filename;
+    const unsigned int length = 32 + Next() % 224;
+    switch (Next() % 6) {
+      case 0:  // Very long title
+        for (unsigned int i = 0; i < length; ++i) {
+          filename += GenerateTitle();
+          filename += Pick(delimiters, _countof(delimiters));
+        }
+        filename += "- 01 [" + GenerateTags(" ") + "]";
+        break;
+      case 1: {  // Deeply nested brackets
+        std::vector<size_t> stack;
+        for (unsigned int i = 0; i < length / 4; ++i) {
+          stack.push_back(Next() % _countof(openers));
+          filename += openers[stack.back()];
+          filename += VaryCase(Pick(tag_keywords_));
+        }
+        for (; !stack.empty(); stack.pop_back())
+          filename += closers[stack.back()];
+        break;
+      }
+      case 2:  // Unbalanced brackets
+        for (unsigned int i = 0; i < length / 2; ++i) {
+          filename += Next() % 2 ? Pick(openers, _countof(openers)) :
+                                   Pick(closers, _countof(closers));
+          filename += GenerateTitle();
+        }
+        break;
+      case 3:  // Numbers everywhere
+        for (unsigned int i = 0; i < length; ++i) {
+          char number[16];
+          std::snprintf(number, sizeof(number), "%u", Next() % 1000);
+          filename += number;
+          filename += Pick(delimiters, _countof(delimiters));
+        }
+        break;
+      case 4:  // Nothing but keywords
+        for (unsigned int i = 0; i < length; ++i) {
+          filename += VaryCase(Pick(tag_keywords_));
+          filename += Pick(delimiters, _countof(delimiters));
+        }
+        break;
+      default:  // Runs of delimiters
+        for (unsigned int i = 0; i < length; ++i) {
+          const std::string delimiter = Pick(delimiters, _countof(delimiters));
+          for (unsigned int j = Next() % 16; j > 0; --j)
+            filename += delimiter;
+          if (Next() % 4 == 0)
+            filename += GenerateTitle();
+        }
+        break;
+    }
+
+    return filename + "." + Pick(extension_keywords_);
+  }
+
+  static std::string Dotted(std::string value) {
+    for (size_t i = 0; i < value.size(); ++i)
+      if (value[i] == ' ')
+        value[i] = '.';
+    return value;
+  }
+
+  unsigned int state_;
+  unsigned int adversarial_rate_;
+  unsigned int mixed_script_rate_;
+  bool keywords_loaded_;
+  std::vector<std::string> tag_keywords_;
+  std::vector<std::string> extension_keywords_;
+  std::vector<std::string> type_keywords_;
+  Series series_;
+};
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_CORPUS_H
\ No newline at end of file
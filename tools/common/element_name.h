@@ -0,0 +1,89 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_ELEMENT_NAME_H
+#define ANITOMY_TOOLS_ELEMENT_NAME_H
+
+#include <cstring>
+#include <string>
+
+#include "../../anitomy/element.h"
+
+namespace anitomy {
+namespace tools {
+
+// Same keys as in test/data.json
+inline const char* ElementCategoryName(ElementCategory category) {
+  static const char* const names[] = {
+    "anime_season",
+    "anime_season_prefix",
+    "anime_title",
+    "anime_type",
+    "anime_year",
+    "audio_term",
+    "device_compatibility",
+    "episode_number",
+    "episode_prefix",
+    "episode_title",
+    "file_checksum",
+    "file_extension",
+    "file_name",
+    "language",
+    "other",
+    "release_group",
+    "release_information",
+    "release_version",
+    "source",
+    "subtitles",
+    "video_resolution",
+    "video_term",
+  };
+  return category < kElementIterateLast ? names[category] : "unknown";
+}
+
+inline ElementCategory ElementCategoryFromName(const char* name) {
+  for (int i = kElementIterateFirst; i < kElementIterateLast; ++i) {
+    const ElementCategory category = static_cast<ElementCategory>(i);
+    if (std::strcmp(ElementCategoryName(category), name) == 0)
+      return category;
+  }
+  return kElementUnknown;
+}
+
+// Parses a comma-separated list of names, e.g. "anime_title,episode_number"
+inline bool ElementCategoryMaskFromNames(const char* names,
+                                         element_category_mask_t& mask) {
+  mask = 0;
+  for (const char* name = names; *name;) {
+    const char* end = std::strchr(name, ',');
+    if (!end)
+      end = name + std::strlen(name);
+    const ElementCategory category =
+        ElementCategoryFromName(std::string(name, end).c_str());
+    if (category == kElementUnknown)
+      return false;
+    mask |= ElementCategoryMask(category);
+    name = *end ? end + 1 : end;
+  }
+  return mask != 0;
+}
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_ELEMENT_NAME_H
\ No newline at end of file
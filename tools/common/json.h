@@ -0,0 +1,296 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_JSON_H
+#define ANITOMY_TOOLS_JSON_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace anitomy {
+namespace tools {
+
+// A small JSON document model for test/data.json and the result files of the
+// tools. Strings are kept as UTF-8, and numbers as they were written as well.
+struct JsonValue {
+  enum Type {
+    kNull,
+    kBoolean,
+    kNumber,
+    kString,
+    kArray,
+    kObject
+  };
+
+  JsonValue() : type(kNull), number(0) {}
+
+  const JsonValue* get(const std::string& key) const {
+    for (size_t i = 0; i < object.size(); ++i)
+      if (object[i].first == key)
+        return &object[i].second;
+    return NULL;
+  }
+
+  double get_number(const std::string& key) const {
+    const JsonValue* value = get(key);
+    return value && value->type == kNumber ? value->number : 0;
+  }
+
+  std::string get_string(const std::string& key) const {
+    const JsonValue* value = get(key);
+    return value && value->type == kString ? value->string : std::string();
+  }
+
+  Type type;
+  double number;  // Also used for kBoolean
+  std::string string;  // Also used for kNumber
+  std::vector<JsonValue> array;
+  std::vector<std::pair<std::string, JsonValue> > object;
+};
+
+class JsonReader {
+public:
+  explicit JsonReader(const std::string& text) : text_(text), pos_(0) {}
+
+  bool Read(JsonValue& value) {
+    if (!ReadValue(value, 0))
+      return false;
+    SkipWhitespace();
+    return pos_ == text_.size();
+  }
+
+private:
+  void SkipWhitespace() {
+    while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' ||
+                                   text_[pos_] == '\r' || text_[pos_] == '\n'))
+      ++pos_;
+  }
+
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  bool ConsumeWord(const char* word) {
+    const std::string expected(word);
+    if (text_.compare(pos_, expected.size(), expected) != 0)
+      return false;
+    pos_ += expected.size();
+    return true;
+  }
+
+  bool ReadValue(JsonValue& value, int depth) {
+    if (depth > 64)
+      return false;
+    SkipWhitespace();
+    if (pos_ >= text_.size())
+      return false;
+
+    switch (text_[pos_]) {
+      case '{': {
+        ++pos_;
+        value.type = JsonValue::kObject;
+        if (Consume('}'))
+          return true;
+        do {
+          value.object.push_back(std::make_pair(std::string(), JsonValue()));
+          std::pair<std::string, JsonValue>& member = value.object.back();
+          SkipWhitespace();
+          if (!ReadString(member.first) || !Consume(':') ||
+              !ReadValue(member.second, depth + 1))
+            return false;
+        } while (Consume(','));
+        return Consume('}');
+      }
+      case '[': {
+        ++pos_;
+        value.type = JsonValue::kArray;
+        if (Consume(']'))
+          return true;
+        do {
+          value.array.push_back(JsonValue());
+          if (!ReadValue(value.array.back(), depth + 1))
+            return false;
+        } while (Consume(','));
+        return Consume(']');
+      }
+      case '"':
+        value.type = JsonValue::kString;
+        return ReadString(value.string);
+      case 't':
+        value.type = JsonValue::kBoolean;
+        value.number = 1;
+        return ConsumeWord("true");
+      case 'f':
+        value.type = JsonValue::kBoolean;
+        return ConsumeWord("false");
+      case 'n':
+        return ConsumeWord("null");
+      default: {
+        const char* begin = text_.c_str() + pos_;
+        char* end = NULL;
+        value.type = JsonValue::kNumber;
+        value.number = std::strtod(begin, &end);
+        if (end == begin)
+          return false;
+        value.string.assign(begin, end - begin);
+        pos_ += end - begin;
+        return true;
+      }
+    }
+  }
+
+  bool ReadString(std::string& value) {
+    if (pos_ >= text_.size() || text_[pos_] != '"')
+      return false;
+    ++pos_;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char c = text_[pos_++];
+      if (c == '\\') {
+        if (pos_ >= text_.size())
+          return false;
+        c = text_[pos_++];
+        switch (c) {
+          case '"': case '\\': case '/': break;
+          case 'b': c = '\b'; break;
+          case 'f': c = '\f'; break;
+          case 'n': c = '\n'; break;
+          case 'r': c = '\r'; break;
+          case 't': c = '\t'; break;
+          case 'u': {
+            unsigned long code_point = 0;
+            if (!ReadCodeUnit(code_point))
+              return false;
+            // Characters outside of the BMP are escaped as surrogate pairs
+            if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+              unsigned long low = 0;
+              if (text_.compare(pos_, 2, "\\u") != 0)
+                return false;
+              pos_ += 2;
+              if (!ReadCodeUnit(low) || low < 0xDC00 || low > 0xDFFF)
+                return false;
+              code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                           (low - 0xDC00);
+            } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+              return false;
+            }
+            AppendUtf8(value, code_point);
+            continue;
+          }
+          default:
+            return false;
+        }
+      }
+      value.push_back(c);
+    }
+    if (pos_ >= text_.size())
+      return false;
+    ++pos_;
+    return true;
+  }
+
+  // Reads the four hex digits of a \u escape
+  bool ReadCodeUnit(unsigned long& code_unit) {
+    if (pos_ + 4 > text_.size())
+      return false;
+    code_unit = 0;
+    for (size_t end = pos_ + 4; pos_ < end; ++pos_) {
+      const char c = text_[pos_];
+      code_unit <<= 4;
+      if (c >= '0' && c <= '9') {
+        code_unit |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        code_unit |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        code_unit |= c - 'A' + 10;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static void AppendUtf8(std::string& output, unsigned long code_point) {
+    if (code_point < 0x80) {
+      output.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+      output.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+      output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+      output.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+      output.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+      output.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+      output.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+  }
+
+  const std::string& text_;
+  size_t pos_;
+};
+
+inline bool LoadJson(const std::string& path, JsonValue& value) {
+  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    return false;
+  const std::string text((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+  return JsonReader(text).Read(value);
+}
+
+// Appends a quoted and escaped string
+inline void AppendJsonString(std::string& output, const std::string& value) {
+  output.push_back('"');
+  for (size_t i = 0; i < value.size(); ++i) {
+    const unsigned char c = static_cast<unsigned char>(value[i]);
+    switch (c) {
+      case '"': output += "\\\""; break;
+      case '\\': output += "\\\\"; break;
+      case '\n': output += "\\n"; break;
+      case '\r': output += "\\r"; break;
+      case '\t': output += "\\t"; break;
+      default:
+        if (c < 0x20) {
+          char escape[8];
+          std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+          output += escape;
+        } else {
+          output.push_back(static_cast<char>(c));
+        }
+        break;
+    }
+  }
+  output.push_back('"');
+}
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_JSON_H
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_TEST_DATA_H
+#define ANITOMY_TOOLS_TEST_DATA_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/options.h"
+#include "../../anitomy/string.h"
+#include "json.h"
+
+namespace anitomy {
+namespace tools {
+
+// An entry of test/data.json. Every field is kept as a list of UTF-8 strings,
+// whether it's a string, a number or an array in the file.
+struct TestEntry {
+  typedef std::map<std::string, std::vector<std::string> > field_container_t;
+
+  std::string get(const std::string& key) const {
+    field_container_t::const_iterator it = fields.find(key);
+    return it != fields.end() && !it->second.empty() ? it->second.front()
+                                                     : std::string();
+  }
+
+  field_container_t fields;
+};
+
+// Strings and numbers as they were written, "true", "false" or nothing
+inline bool GetTestValue(const JsonValue& json, std::string& value) {
+  switch (json.type) {
+    case JsonValue::kString:
+    case JsonValue::kNumber:
+      value = json.string;
+      return true;
+    case JsonValue::kBoolean:
+      value = json.number ? "true" : "false";
+      return true;
+    default:
+      return false;
+  }
+}
+
+// test/data.json is an array of flat objects
+inline bool LoadTestData(const std::string& path,
+                         std::vector<TestEntry>& entries) {
+  JsonValue document;
+  if (!LoadJson(path, document) || document.type != JsonValue::kArray)
+    return false;
+
+  entries.resize(document.array.size());
+  for (size_t i = 0; i < document.array.size(); ++i) {
+    const JsonValue& object = document.array[i];
+    if (object.type != JsonValue::kObject)
+      return false;
+    for (size_t j = 0; j < object.object.size(); ++j) {
+      const JsonValue& field = object.object[j].second;
+      std::vector<std::string>& values =
+          entries[i].fields[object.object[j].first];
+      if (field.type == JsonValue::kArray) {
+        values.resize(field.array.size());
+        for (size_t k = 0; k < field.array.size(); ++k)
+          if (!GetTestValue(field.array[k], values[k]))
+            return false;
+      } else {
+        values.resize(1);
+        if (!GetTestValue(field, values[0]))
+          return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Entries may override the default options
+inline void ApplyTestOptions(const TestEntry& entry, Options& options) {
+  options = Options();
+
+  TestEntry::field_container_t::const_iterator it =
+      entry.fields.find("option_allowed_delimiters");
+  if (it != entry.fields.end() && !it->second.empty())
+    options.allowed_delimiters = Utf8ToString(it->second.front());
+
+  it = entry.fields.find("option_ignored_strings");
+  if (it != entry.fields.end())
+    for (size_t i = 0; i < it->second.size(); ++i)
+      options.ignored_strings.push_back(Utf8ToString(it->second[i]));
+}
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_TEST_DATA_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANITOMY_TOOLS_TEST_RUNNER_H
+#define ANITOMY_TOOLS_TEST_RUNNER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/anitomy.h"
+#include "test_data.h"
+
+namespace anitomy {
+namespace tools {
+
+// What the tests that run over test/data.json have in common: the file is
+// given on the command line, every entry is parsed with its own options, and
+// failures are counted and reported the same way.
+
+inline int& TestFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+inline void Fail(const std::string& name, const char* reason) {
+  std::printf("FAIL: %s\n      %s\n", name.c_str(), reason);
+  ++TestFailures();
+}
+
+// Reads the file given as the first argument, test/data.json by default
+inline bool LoadTestEntries(int argc, char* argv[],
+                            std::vector<TestEntry>& entries) {
+  const std::string path = argc > 1 ? argv[1] : "test/data.json";
+  if (!LoadTestData(path, entries)) {
+    std::printf("Cannot read %s\n", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Applies the options of each entry to `anitomy`, then calls
+// check(filename, anitomy) with the UTF-8 filename of the entry. `check` can
+// be a function, or an object that keeps state between entries.
+template <class Check>
+void ForEachTestEntry(const std::vector<TestEntry>& entries, Anitomy& anitomy,
+                      Check& check) {
+  for (std::vector<TestEntry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry) {
+    ApplyTestOptions(*entry, anitomy.options());
+    check(entry->get("file_name"), anitomy);
+  }
+}
+
+// Prints the summary line, and returns the exit code of the test
+inline int ReportTestResults(size_t entry_count) {
+  std::printf("%lu entries, %d failures\n",
+              static_cast<unsigned long>(entry_count), TestFailures());
+  return TestFailures() == 0 ? 0 : 1;
+}
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_TEST_RUNNER_H
\ No newline at end of file
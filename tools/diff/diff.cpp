@@ -0,0 +1,305 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/anitomy.h"
+#include "../common/corpus.h"
+#include "../common/element_name.h"
+#include "../common/test_data.h"
+#include "engine.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+namespace {
+
+struct DiffOptions {
+  DiffOptions()
+      : count(100000), seed(1), iterations(3), max_reports(20) {}
+
+  std::string data;
+  std::string input;
+  size_t count;
+  unsigned int seed;
+  size_t iterations;
+  size_t max_reports;
+};
+
+struct DiffInput {
+  string_t filename;
+  Options options;
+};
+
+struct Engine {
+  const char* name;
+  void* (*Create)();
+  void (*Destroy)(void* parser);
+  void (*SetOptions)(void* parser, const std::wstring& allowed_delimiters,
+                     const std::vector<std::wstring>& ignored_strings);
+  bool (*Parse)(void* parser, const std::wstring& filename);
+  void (*GetResult)(void* parser, EngineResult& result);
+};
+
+const Engine kEngines[] = {
+  {"reference", reference::Create, reference::Destroy, reference::SetOptions,
+   reference::Parse, reference::GetResult},
+  {"current", current::Create, current::Destroy, current::SetOptions,
+   current::Parse, current::GetResult},
+};
+
+int PrintUsage() {
+  std::fprintf(stderr,
+      "Usage: anitomy-diff [--data test/data.json] [--input file]\n"
+      "                    [--count n] [--seed n] [--iterations n]\n"
+      "                    [--max-reports n]\n"
+      "\n"
+      "Parses the entries of --data, the filenames in --input (one per\n"
+      "line) and --count filenames of the standard corpus with both the\n"
+      "reference and the current build, reports every difference in their\n"
+      "elements, and compares their throughput over --iterations passes.\n");
+  return 1;
+}
+
+bool ParseOptions(int argc, char* argv[], DiffOptions& options) {
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && std::strcmp(argv[i], "--data") == 0) {
+      options.data = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--input") == 0) {
+      options.input = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--count") == 0) {
+      options.count = std::strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--seed") == 0) {
+      options.seed = std::strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--iterations") == 0) {
+      options.iterations = std::strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--max-reports") == 0) {
+      options.max_reports = std::strtoul(argv[++i], NULL, 10);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoadInputs(const DiffOptions& options, std::vector<DiffInput>& inputs) {
+  if (!options.data.empty()) {
+    std::vector<TestEntry> entries;
+    if (!LoadTestData(options.data, entries)) {
+      std::fprintf(stderr, "Cannot read %s\n", options.data.c_str());
+      return false;
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+      DiffInput input;
+      input.filename = Utf8ToString(entries[i].get("file_name"));
+      ApplyTestOptions(entries[i], input.options);
+      inputs.push_back(input);
+    }
+  }
+
+  if (!options.input.empty()) {
+    std::ifstream file(options.input.c_str());
+    if (!file) {
+      std::fprintf(stderr, "Cannot read %s\n", options.input.c_str());
+      return false;
+    }
+    std::string line;
+    DiffInput input;
+    while (std::getline(file, line)) {
+      if (line.empty())
+        continue;
+      input.filename = Utf8ToString(line);
+      inputs.push_back(input);
+    }
+  }
+
+  CorpusGenerator generator(options.seed);
+  DiffInput input;
+  for (size_t i = 0; i < options.count; ++i) {
+    input.filename = Utf8ToString(generator.NextFilename());
+    inputs.push_back(input);
+  }
+
+  return true;
+}
+
+void SetOptions(const Engine& engine, void* parser, const Options& options) {
+  engine.SetOptions(parser, options.allowed_delimiters,
+                    options.ignored_strings);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string FormatElements(const EngineResult& result, int category) {
+  std::string values;
+  for (size_t i = 0; i < result.elements.size(); ++i) {
+    if (result.elements[i].first != category)
+      continue;
+    if (!values.empty())
+      values += " | ";
+    values += "\"" + result.elements[i].second + "\"";
+  }
+  return values.empty() ? "(none)" : values;
+}
+
+void PrintTokens(const char* name, const EngineResult& result) {
+  static const char* const categories[] = {
+    "unknown", "bracket", "delimiter", "identifier", "invalid",
+  };
+
+  std::printf("  %s tokens:", name);
+  for (size_t i = 0; i < result.tokens.size(); ++i) {
+    const EngineToken& token = result.tokens[i];
+    const int category = token.category;
+    std::printf(" %s%s:\"%s\"", token.enclosed ? "+" : "",
+                category >= 0 && category < static_cast<int>(_countof(categories)) ?
+                    categories[category] : "?",
+                token.content.c_str());
+  }
+  std::printf("\n");
+}
+
+void PrintMismatch(const string_t& filename, const EngineResult& reference,
+                   const EngineResult& current) {
+  std::printf("%s\n", StringToUtf8(filename).c_str());
+  if (reference.success != current.success)
+    std::printf("  success: %d != %d\n", reference.success, current.success);
+
+  for (int category = kElementIterateFirst; category < kElementIterateLast;
+       ++category) {
+    const std::string a = FormatElements(reference, category);
+    const std::string b = FormatElements(current, category);
+    if (a != b)
+      std::printf("  %s: %s != %s\n",
+                  ElementCategoryName(static_cast<ElementCategory>(category)),
+                  a.c_str(), b.c_str());
+  }
+  if (reference.elements.size() == current.elements.size() &&
+      reference.elements != current.elements)
+    std::printf("  (same values in a different order)\n");
+
+  PrintTokens("reference", reference);
+  PrintTokens("current", current);
+}
+
+bool AreTokensEqual(const EngineResult& a, const EngineResult& b) {
+  if (a.tokens.size() != b.tokens.size())
+    return false;
+  for (size_t i = 0; i < a.tokens.size(); ++i)
+    if (a.tokens[i].category != b.tokens[i].category ||
+        a.tokens[i].content != b.tokens[i].content ||
+        a.tokens[i].enclosed != b.tokens[i].enclosed)
+      return false;
+  return true;
+}
+
+// Every field is compared, order included; token differences alone are
+// counted, but don't fail the run
+size_t CompareEngines(const DiffOptions& options,
+                      const std::vector<DiffInput>& inputs,
+                      size_t& token_mismatches) {
+  void* reference = kEngines[0].Create();
+  void* current = kEngines[1].Create();
+  EngineResult reference_result, current_result;
+  size_t mismatches = 0;
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    SetOptions(kEngines[0], reference, inputs[i].options);
+    SetOptions(kEngines[1], current, inputs[i].options);
+    reference_result.success = kEngines[0].Parse(reference, inputs[i].filename);
+    current_result.success = kEngines[1].Parse(current, inputs[i].filename);
+    kEngines[0].GetResult(reference, reference_result);
+    kEngines[1].GetResult(current, current_result);
+
+    if (reference_result.success != current_result.success ||
+        reference_result.elements != current_result.elements) {
+      if (mismatches++ < options.max_reports)
+        PrintMismatch(inputs[i].filename, reference_result, current_result);
+    } else if (!AreTokensEqual(reference_result, current_result)) {
+      ++token_mismatches;
+    }
+  }
+
+  kEngines[0].Destroy(reference);
+  kEngines[1].Destroy(current);
+  return mismatches;
+}
+
+double MeasureThroughput(const Engine& engine, const DiffOptions& options,
+                         const std::vector<DiffInput>& inputs) {
+  void* parser = engine.Create();
+
+  // Warm up
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    SetOptions(engine, parser, inputs[i].options);
+    engine.Parse(parser, inputs[i].filename);
+  }
+
+  const unsigned long long start = GetStatsClock();
+  for (size_t iteration = 0; iteration < options.iterations; ++iteration) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      SetOptions(engine, parser, inputs[i].options);
+      engine.Parse(parser, inputs[i].filename);
+    }
+  }
+  const unsigned long long elapsed = GetStatsClock() - start;
+
+  engine.Destroy(parser);
+  return elapsed ? static_cast<double>(inputs.size()) * options.iterations *
+                   1e9 / elapsed : 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  DiffOptions options;
+  if (!ParseOptions(argc, argv, options))
+    return PrintUsage();
+
+  std::vector<DiffInput> inputs;
+  if (!LoadInputs(options, inputs))
+    return 1;
+
+  size_t token_mismatches = 0;
+  const size_t mismatches = CompareEngines(options, inputs, token_mismatches);
+  if (mismatches > options.max_reports)
+    std::printf("... %lu more\n",
+                static_cast<unsigned long>(mismatches - options.max_reports));
+  std::printf("%lu filenames, %lu mismatches, %lu with different tokens "
+              "only\n\n",
+              static_cast<unsigned long>(inputs.size()),
+              static_cast<unsigned long>(mismatches),
+              static_cast<unsigned long>(token_mismatches));
+
+  if (options.iterations) {
+    double throughput[_countof(kEngines)];
+    for (size_t i = 0; i < _countof(kEngines); ++i) {
+      throughput[i] = MeasureThroughput(kEngines[i], options, inputs);
+      std::printf("%-10s %12.0f parses/s\n", kEngines[i].name, throughput[i]);
+    }
+    if (throughput[0] > 0)
+      std::printf("current is %.2fx the reference\n",
+                  throughput[1] / throughput[0]);
+  }
+
+  return mismatches ? 1 : 0;
+}
\ No newline at end of file
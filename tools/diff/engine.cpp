@@ -0,0 +1,84 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// Compiled once per build under test, with ANITOMY_DIFF_ENGINE set to the
+// name of the engine (reference or current) and the directory of the build's
+// headers given with -iquote. The reference build is also compiled with
+// -Danitomy=anitomy_reference, so that both builds can be linked together.
+
+#include "anitomy.h"
+
+#ifndef ANITOMY_DIFF_ENGINE
+#error "ANITOMY_DIFF_ENGINE must be defined"
+#endif
+
+namespace library = anitomy;
+#undef anitomy
+
+#include "engine.h"
+
+namespace anitomy {
+namespace tools {
+namespace ANITOMY_DIFF_ENGINE {
+
+void* Create() {
+  return new library::Anitomy;
+}
+
+void Destroy(void* parser) {
+  delete static_cast<library::Anitomy*>(parser);
+}
+
+void SetOptions(void* parser, const std::wstring& allowed_delimiters,
+                const std::vector<std::wstring>& ignored_strings) {
+  library::Options& options = static_cast<library::Anitomy*>(parser)->options();
+  options = library::Options();
+  options.allowed_delimiters = allowed_delimiters;
+  options.ignored_strings.assign(ignored_strings.begin(),
+                                 ignored_strings.end());
+}
+
+bool Parse(void* parser, const std::wstring& filename) {
+  return static_cast<library::Anitomy*>(parser)->Parse(filename);
+}
+
+void GetResult(void* parser, EngineResult& result) {
+  library::Anitomy& anitomy = *static_cast<library::Anitomy*>(parser);
+
+  result.elements.clear();
+  const library::Elements& elements = anitomy.elements();
+  for (library::element_const_iterator_t element = elements.begin();
+       element != elements.end(); ++element)
+    result.elements.push_back(std::make_pair(
+        static_cast<int>(element->first),
+        library::StringToUtf8(element->second)));
+
+  result.tokens.clear();
+  const library::token_container_t& tokens = anitomy.tokens();
+  for (library::token_container_t::const_iterator token = tokens.begin();
+       token != tokens.end(); ++token) {
+    EngineToken engine_token;
+    engine_token.category = token->category;
+    engine_token.content = library::StringToUtf8(token->content);
+    engine_token.enclosed = token->enclosed;
+    result.tokens.push_back(engine_token);
+  }
+}
+
+}  // namespace ANITOMY_DIFF_ENGINE
+}  // namespace tools
+}  // namespace anitomy
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ANITOMY_TOOLS_DIFF_ENGINE_H
+#define ANITOMY_TOOLS_DIFF_ENGINE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// The interface between the harness and a build of the library. engine.cpp
+// is compiled once against each build, and must not depend on the types of
+// either, so only standard types cross it.
+
+namespace anitomy {
+namespace tools {
+
+struct EngineToken {
+  int category;
+  std::string content;
+  bool enclosed;
+};
+
+struct EngineResult {
+  bool success;
+  std::vector<std::pair<int, std::string> > elements;  // UTF-8 values
+  std::vector<EngineToken> tokens;
+};
+
+#define ANITOMY_DECLARE_DIFF_ENGINE(name) \
+    namespace name { \
+    void* Create(); \
+    void Destroy(void* parser); \
+    void SetOptions(void* parser, const std::wstring& allowed_delimiters, \
+                    const std::vector<std::wstring>& ignored_strings); \
+    bool Parse(void* parser, const std::wstring& filename); \
+    void GetResult(void* parser, EngineResult& result); \
+    }
+
+ANITOMY_DECLARE_DIFF_ENGINE(reference)
+ANITOMY_DECLARE_DIFF_ENGINE(current)
+
+}  // namespace tools
+}  // namespace anitomy
+
+#endif  // ANITOMY_TOOLS_DIFF_ENGINE_H
\ No newline at end of file
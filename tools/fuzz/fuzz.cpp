@@ -0,0 +1,368 @@
+/*
+** Anitomy
+** Copyright (C) 2014-2015, Eren Okka
+** 
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+** 
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+** 
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// Searches for filenames that take far longer to parse than their length
+// would suggest: regex backtracking, repeated erasing of ignored strings,
+// rescans of the token list and the like.
+//
+// Built as is, it mutates the filenames of test/data.json and of the standard
+// corpus, keeps the inputs that are slowest for their length, and minimizes
+// and saves every input over the --threshold (ns per character). Saved inputs
+// form a regression corpus, one filename per line, that can be replayed with
+// --replay or benchmarked with `anitomy-bench parse --input`.
+//
+// Built with -DANITOMY_LIBFUZZER and -fsanitize=fuzzer, it is a libFuzzer
+// target that aborts on slow inputs, so that libFuzzer saves them. The
+// threshold is then read from ANITOMY_FUZZ_THRESHOLD.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../../anitomy/anitomy.h"
+#include "../common/corpus.h"
+#include "../common/test_data.h"
+
+using namespace anitomy;
+using namespace anitomy::tools;
+
+namespace {
+
+// Short inputs are dominated by fixed costs
+const size_t kMinimumLength = 16;
+
+struct FuzzOptions {
+  FuzzOptions()
+      : seed(1), runs(100000), max_length(1024), threshold(5000) {}
+
+  unsigned int seed;
+  size_t runs;
+  size_t max_length;
+  double threshold;
+  std::string data;
+  std::string save;
+  std::string replay;
+  std::vector<string_t> ignored_strings;
+};
+
+double GetNsPerChar(unsigned long long nanoseconds, size_t length) {
+  return nanoseconds /
+      static_cast<double>(length > kMinimumLength ? length : kMinimumLength);
+}
+
+// The fastest of a few parses, to filter out preemption and cache misses
+double MeasureNsPerChar(Anitomy& anitomy, const string_t& filename,
+                        int repeats) {
+  unsigned long long best = 0;
+  for (int i = 0; i < repeats; ++i) {
+    const unsigned long long start = GetStatsClock();
+    anitomy.Parse(filename);
+    const unsigned long long elapsed = GetStatsClock() - start;
+    if (i == 0 || elapsed < best)
+      best = elapsed;
+  }
+  return GetNsPerChar(best, filename.size());
+}
+
+bool IsSlow(Anitomy& anitomy, const string_t& filename, double threshold) {
+  return filename.size() >= kMinimumLength &&
+         MeasureNsPerChar(anitomy, filename, 5) > threshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Everything below is only used by the standalone fuzzer
+#ifndef ANITOMY_LIBFUZZER
+
+class Mutator {
+public:
+  explicit Mutator(unsigned int seed) : state_(seed) {}
+
+  string_t Mutate(const string_t& input, const std::vector<string_t>& pool,
+                  size_t max_length) {
+    static const char_t alphabet[] =
+        L" _.-&+,|~#[](){}"
+        L"\x300C\x300D\x300E\x300F\x3010\x3011"
+        L"0123456789vVxXeEpPsS";
+    static const char_t* const pieces[] = {
+      L"01", L"v2", L"01v2", L"01-02", L"S01E01", L"Ep", L"Episode ",
+      L"1080p", L"1280x720", L"x264", L"AAC", L"[", L"]", L" - ", L"(2009)",
+      L"\x7B2C", L"\x8A71", L"1.5", L"#", L"~", L"ABCD1234",
+    };
+
+    string_t output = input;
+    const unsigned int count = 1 + Next() % 4;
+    for (unsigned int i = 0; i < count; ++i) {
+      const size_t position = output.empty() ? 0 : Next() % (output.size() + 1);
+      switch (Next() % 6) {
+        case 0:
+          output.insert(position, 1, alphabet[Next() % (_countof(alphabet) - 1)]);
+          break;
+        case 1:
+          if (position < output.size())
+            output.erase(position, 1 + Next() % (output.size() - position));
+          break;
+        case 2:
+          if (position < output.size()) {
+            const string_t chunk = output.substr(position, 1 + Next() % 8);
+            for (unsigned int j = 1 + Next() % 16; j > 0; --j)
+              output.insert(position, chunk);
+          }
+          break;
+        case 3:
+          if (position < output.size())
+            output[position] = alphabet[Next() % (_countof(alphabet) - 1)];
+          break;
+        case 4: {
+          const string_t& other = pool[Next() % pool.size()];
+          if (!other.empty()) {
+            const size_t begin = Next() % other.size();
+            output.insert(position, other.substr(begin, 1 + Next() % 32));
+          }
+          break;
+        }
+        default:
+          output.insert(position, pieces[Next() % _countof(pieces)]);
+          break;
+      }
+    }
+
+    if (output.size() > max_length)
+      output.resize(max_length);
+    return output;
+  }
+
+private:
+  unsigned int Next() {
+    state_ = state_ * 1664525U + 1013904223U;
+    return state_ >> 8;
+  }
+
+  unsigned int state_;
+};
+
+// Letters and digits collapsed into runs, so that inputs that differ only in
+// their words and numbers are reported once
+string_t GetShape(const string_t& input) {
+  string_t shape;
+  for (size_t i = 0; i < input.size(); ++i) {
+    char_t c = input[i];
+    if (IsAlphanumericChar(c))
+      c = IsNumericChar(c) ? L'0' : L'a';
+    if (shape.empty() || shape[shape.size() - 1] != c || !IsAlphanumericChar(c))
+      shape.push_back(c);
+  }
+  return shape;
+}
+
+// Removes chunks, from large to small, for as long as the input stays slow
+string_t Minimize(Anitomy& anitomy, string_t input, double threshold) {
+  for (size_t chunk = input.size() / 2; chunk > 0; chunk /= 2) {
+    for (size_t position = 0; position + chunk <= input.size(); ) {
+      string_t candidate = input;
+      candidate.erase(position, chunk);
+      if (IsSlow(anitomy, candidate, threshold)) {
+        input = candidate;
+      } else {
+        position += chunk;
+      }
+    }
+  }
+  return input;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int PrintUsage() {
+  std::fprintf(stderr,
+      "Usage: anitomy-fuzz [--data test/data.json] [--seed n] [--runs n]\n"
+      "                    [--max-length n] [--threshold ns] [--save file]\n"
+      "                    [--ignore string]...\n"
+      "       anitomy-fuzz --replay file [--threshold ns] [--ignore string]...\n");
+  return 1;
+}
+
+bool ParseOptions(int argc, char* argv[], FuzzOptions& options) {
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && std::strcmp(argv[i], "--data") == 0) {
+      options.data = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--seed") == 0) {
+      options.seed = std::strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--runs") == 0) {
+      options.runs = std::strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--max-length") == 0) {
+      options.max_length = std::strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--threshold") == 0) {
+      options.threshold = std::strtod(argv[++i], NULL);
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--save") == 0) {
+      options.save = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--replay") == 0) {
+      options.replay = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--ignore") == 0) {
+      options.ignored_strings.push_back(Utf8ToString(argv[++i]));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+int Replay(Anitomy& anitomy, const FuzzOptions& options) {
+  std::ifstream file(options.replay.c_str());
+  if (!file) {
+    std::fprintf(stderr, "Cannot read %s\n", options.replay.c_str());
+    return 1;
+  }
+
+  size_t count = 0;
+  size_t slow = 0;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty())
+      continue;
+    const string_t filename = Utf8ToString(line);
+    const double ns_per_char = MeasureNsPerChar(anitomy, filename, 5);
+    ++count;
+    if (filename.size() >= kMinimumLength && ns_per_char > options.threshold) {
+      std::printf("%10.1f ns/char  %s\n", ns_per_char, line.c_str());
+      ++slow;
+    }
+  }
+
+  std::printf("%lu inputs, %lu over %.1f ns/char\n",
+              static_cast<unsigned long>(count),
+              static_cast<unsigned long>(slow), options.threshold);
+  return slow ? 1 : 0;
+}
+
+int Fuzz(Anitomy& anitomy, const FuzzOptions& options) {
+  std::vector<string_t> pool;
+  if (!options.data.empty()) {
+    std::vector<TestEntry> entries;
+    if (!LoadTestData(options.data, entries)) {
+      std::fprintf(stderr, "Cannot read %s\n", options.data.c_str());
+      return 1;
+    }
+    for (size_t i = 0; i < entries.size(); ++i)
+      pool.push_back(Utf8ToString(entries[i].get("file_name")));
+  }
+  CorpusGenerator(options.seed).Generate(1000, pool);
+
+  // The slowest input seen for each power of two of length
+  std::vector<double> worst(32, 0);
+  std::set<string_t> found;
+  FILE* save = NULL;
+  Mutator mutator(options.seed);
+
+  for (size_t run = 0; run < options.runs; ++run) {
+    const string_t input = mutator.Mutate(pool[run % pool.size()], pool,
+                                          options.max_length);
+    if (input.size() < kMinimumLength)
+      continue;
+
+    double ns_per_char = MeasureNsPerChar(anitomy, input, 1);
+    size_t bucket = 0;
+    while ((kMinimumLength << (bucket + 1)) <= input.size())
+      ++bucket;
+    if (ns_per_char > worst[bucket]) {
+      ns_per_char = MeasureNsPerChar(anitomy, input, 5);
+      if (ns_per_char > worst[bucket]) {
+        // Keep the slowest inputs around, so that they are mutated further
+        worst[bucket] = ns_per_char;
+        pool.push_back(input);
+      }
+    }
+
+    if (ns_per_char <= options.threshold ||
+        !IsSlow(anitomy, input, options.threshold))
+      continue;
+
+    const string_t minimized = Minimize(anitomy, input, options.threshold);
+    if (!found.insert(GetShape(minimized)).second)
+      continue;
+    const std::string line = StringToUtf8(minimized);
+    std::printf("%10.1f ns/char  %s\n",
+                MeasureNsPerChar(anitomy, minimized, 5), line.c_str());
+    std::fflush(stdout);
+
+    if (!options.save.empty()) {
+      if (!save)
+        save = std::fopen(options.save.c_str(), "ab");
+      if (save) {
+        std::fprintf(save, "%s\n", line.c_str());
+        std::fflush(save);
+      }
+    }
+  }
+  if (save)
+    std::fclose(save);
+
+  std::printf("\n%-12s %12s\n", "length", "worst ns/char");
+  for (size_t i = 0; i < worst.size(); ++i)
+    if (worst[i] > 0)
+      std::printf("%5lu-%-6lu %12.1f\n",
+                  static_cast<unsigned long>(kMinimumLength << i),
+                  static_cast<unsigned long>((kMinimumLength << (i + 1)) - 1),
+                  worst[i]);
+  std::printf("%lu runs, %lu inputs over %.1f ns/char\n",
+              static_cast<unsigned long>(options.runs),
+              static_cast<unsigned long>(found.size()), options.threshold);
+
+  return found.empty() ? 0 : 1;
+}
+
+#endif  // ANITOMY_LIBFUZZER
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char* data, size_t size) {
+  static Anitomy anitomy;
+  static double threshold = 0;
+  if (threshold == 0) {
+    const char* value = std::getenv("ANITOMY_FUZZ_THRESHOLD");
+    threshold = value ? std::strtod(value, NULL) : FuzzOptions().threshold;
+  }
+
+  const string_t filename =
+      Utf8ToString(std::string(reinterpret_cast<const char*>(data), size));
+  const double ns_per_char = MeasureNsPerChar(anitomy, filename, 1);
+  if (filename.size() >= kMinimumLength && ns_per_char > threshold &&
+      IsSlow(anitomy, filename, threshold)) {
+    std::fprintf(stderr, "Slow input: %.1f ns/char\n", ns_per_char);
+    std::abort();
+  }
+  return 0;
+}
+
+#ifndef ANITOMY_LIBFUZZER
+int main(int argc, char* argv[]) {
+  FuzzOptions options;
+  if (!ParseOptions(argc, argv, options))
+    return PrintUsage();
+
+  Anitomy anitomy;
+  anitomy.options().ignored_strings = options.ignored_strings;
+
+  if (!options.replay.empty())
+    return Replay(anitomy, options);
+  return Fuzz(anitomy, options);
+}
+#endif
\ No newline at end of file